@@ -63,6 +63,45 @@ FlowLayout::~FlowLayout()
 void FlowLayout::addItem(QLayoutItem *item)
 {
     itemList.append(item);
+    m_geometries.append(QRect());
+    m_heights.clear();
+    if (QWidget *widget = item->widget()) {
+        widget->installEventFilter(this);
+        m_widgetItems[widget] = item;
+    }
+}
+
+void FlowLayout::beginInsert()
+{
+    m_inserting = true;
+}
+
+void FlowLayout::endInsert()
+{
+    m_inserting = false;
+    // single relayout for all inserted items
+    QLayout::invalidate();
+    if (m_pendingGeometry) {
+        m_pendingGeometry = false;
+        doLayout(geometry(), false);
+    }
+}
+
+bool FlowLayout::eventFilter(QObject *watched, QEvent *event)
+{
+    // size hint of the widget may have been changed
+    switch (event->type()) {
+    case QEvent::ShowToParent:
+    case QEvent::HideToParent:
+    case QEvent::FontChange:
+    case QEvent::StyleChange:
+    case QEvent::LayoutRequest:
+        m_sizeHints.remove(m_widgetItems.value(watched));
+        break;
+    default:
+        break;
+    }
+    return QLayout::eventFilter(watched, event);
 }
 
 int FlowLayout::horizontalSpacing() const
@@ -95,10 +134,29 @@ QLayoutItem *FlowLayout::itemAt(int index) const
 
 QLayoutItem *FlowLayout::takeAt(int index)
 {
-    if (index >= 0 && index < itemList.size())
-        return itemList.takeAt(index);
-    else
+    if (index >= 0 && index < itemList.size()) {
+        QLayoutItem *item = itemList.takeAt(index);
+        m_sizeHints.remove(item);
+        if (QWidget *widget = item->widget()) {
+            widget->removeEventFilter(this);
+            m_widgetItems.remove(widget);
+        }
+        m_geometries.removeAt(index);
+        m_heights.clear();
+        return item;
+    } else {
         return 0;
+    }
+}
+
+void FlowLayout::invalidate()
+{
+    // hints of changed children are dropped by eventFilter(), thus only
+    // cached heights are reset here. Qt calls it on each child show and
+    // hide, thus it is deferred while inserting
+    m_heights.clear();
+    if (!m_inserting)
+        QLayout::invalidate();
 }
 
 Qt::Orientations FlowLayout::expandingDirections() const
@@ -113,14 +171,18 @@ bool FlowLayout::hasHeightForWidth() const
 
 int FlowLayout::heightForWidth(int width) const
 {
-    int height = doLayout(QRect(0, 0, width, 0), true);
-    return height;
+    if (!m_heights.contains(width))
+        m_heights[width] = doLayout(QRect(0, 0, width, 0), true);
+    return m_heights[width];
 }
 
 void FlowLayout::setGeometry(const QRect &rect)
 {
     QLayout::setGeometry(rect);
-    doLayout(rect, false);
+    if (m_inserting)
+        m_pendingGeometry = true;
+    else
+        doLayout(rect, false);
 }
 
 QSize FlowLayout::sizeHint() const
@@ -148,33 +210,56 @@ int FlowLayout::doLayout(const QRect &rect, bool testOnly) const
     int y = effectiveRect.y();
     int lineHeight = 0;
 
-    QLayoutItem *item;
-    foreach (item, itemList) {
-        QWidget *wid = item->widget();
-        int spaceX = horizontalSpacing();
+    // all items use the same style, thus spacing is the same for them
+    int spaceX = horizontalSpacing();
+    int spaceY = verticalSpacing();
+    if ((spaceX == -1 || spaceY == -1) && !itemList.isEmpty()) {
+        QWidget *wid = itemList.first()->widget();
+        QStyle *style = wid ? wid->style() : QApplication::style();
         if (spaceX == -1)
-            spaceX = wid->style()->layoutSpacing(
+            spaceX = style->layoutSpacing(
                 QSizePolicy::PushButton, QSizePolicy::PushButton, Qt::Horizontal);
-        int spaceY = verticalSpacing();
         if (spaceY == -1)
-            spaceY = wid->style()->layoutSpacing(
+            spaceY = style->layoutSpacing(
                 QSizePolicy::PushButton, QSizePolicy::PushButton, Qt::Vertical);
-        int nextX = x + item->sizeHint().width() + spaceX;
+    }
+
+    for (int i = 0; i < itemList.size(); ++i) {
+        QSize hint = itemSizeHint(i);
+        int nextX = x + hint.width() + spaceX;
         if (nextX - spaceX > effectiveRect.right() && lineHeight > 0) {
             x = effectiveRect.x();
             y = y + lineHeight + spaceY;
-            nextX = x + item->sizeHint().width() + spaceX;
+            nextX = x + hint.width() + spaceX;
             lineHeight = 0;
         }
 
-        if (!testOnly)
-            item->setGeometry(QRect(QPoint(x, y), item->sizeHint()));
+        // only items after the first changed one are actually moved, hidden
+        // items are not moved by QWidgetItem, thus they are not cached
+        QRect geometry(QPoint(x, y), hint);
+        if (!testOnly && m_geometries.at(i) != geometry) {
+            QLayoutItem *item = itemList.at(i);
+            item->setGeometry(geometry);
+            m_geometries[i] = item->isEmpty() ? QRect() : geometry;
+        }
 
         x = nextX;
-        lineHeight = qMax(lineHeight, item->sizeHint().height());
+        lineHeight = qMax(lineHeight, hint.height());
     }
     return y + lineHeight - rect.y() + bottom;
 }
+QSize FlowLayout::itemSizeHint(int index) const
+{
+    QLayoutItem *item = itemList.at(index);
+    QHash<QLayoutItem *, QSize>::const_iterator hint
+        = m_sizeHints.constFind(item);
+    if (hint != m_sizeHints.constEnd())
+        return hint.value();
+    QSize size = item->sizeHint();
+    m_sizeHints.insert(item, size);
+    return size;
+}
+
 int FlowLayout::smartSpacing(QStyle::PixelMetric pm) const
 {
     QObject *parent = this->parent();
@@ -41,6 +41,7 @@
 #ifndef FLOWLAYOUT_H
 #define FLOWLAYOUT_H
 
+#include <QHash>
 #include <QLayout>
 #include <QRect>
 #include <QStyle>
@@ -52,12 +53,16 @@ public:
     ~FlowLayout();
 
     void addItem(QLayoutItem *item) Q_DECL_OVERRIDE;
+    void beginInsert();
+    void endInsert();
+    bool eventFilter(QObject *watched, QEvent *event) Q_DECL_OVERRIDE;
     int horizontalSpacing() const;
     int verticalSpacing() const;
     Qt::Orientations expandingDirections() const Q_DECL_OVERRIDE;
     bool hasHeightForWidth() const Q_DECL_OVERRIDE;
     int heightForWidth(int) const Q_DECL_OVERRIDE;
     int count() const Q_DECL_OVERRIDE;
+    void invalidate() Q_DECL_OVERRIDE;
     QLayoutItem *itemAt(int index) const Q_DECL_OVERRIDE;
     QSize minimumSize() const Q_DECL_OVERRIDE;
     void setGeometry(const QRect &rect) Q_DECL_OVERRIDE;
@@ -66,11 +71,23 @@ public:
 
 private:
     int doLayout(const QRect &rect, bool testOnly) const;
+    QSize itemSizeHint(int index) const;
     int smartSpacing(QStyle::PixelMetric pm) const;
 
     QList<QLayoutItem *> itemList;
     int m_hSpace;
     int m_vSpace;
+    // cached size hints, missing hint should be requested
+    mutable QHash<QLayoutItem *, QSize> m_sizeHints;
+    // items by their widgets, only hint of the changed widget is dropped
+    QHash<QObject *, QLayoutItem *> m_widgetItems;
+    // cached heightForWidth results by width
+    mutable QHash<int, int> m_heights;
+    // last applied geometries, items are moved only if they are changed
+    mutable QList<QRect> m_geometries;
+    // bulk insertion state, geometry is applied in endInsert()
+    bool m_inserting = false;
+    bool m_pendingGeometry = false;
 };
 
 #endif // FLOWLAYOUT_H
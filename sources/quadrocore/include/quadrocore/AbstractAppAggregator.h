@@ -29,6 +29,7 @@
 // QMap class required because applications should be sorted
 #include <QMap>
 #include <QObject>
+#include <QStringList>
 
 
 /**
@@ -86,6 +87,14 @@ public:
      */
     static QStringList availableCategories();
 
+    /**
+     * @brief current generation of application list
+     * @remark generation is increased each time when application list has
+     * been changed
+     * @return generation number
+     */
+    uint generation() const;
+
     /**
      * @brief return applications which has desktop files
      * @return map of generated ApplicationItem
@@ -100,6 +109,23 @@ public:
      */
     bool hasApplication(const QString &_name) const;
 
+    /**
+     * @brief names which are presented in the first list only
+     * @param _left the first list
+     * @param _right the second list
+     * @return names from the first list which are not in the second one in
+     * the same order
+     */
+    static QStringList difference(const QStringList &_left,
+                                  const QStringList &_right);
+
+    /**
+     * @brief application names in the order in which they should be shown
+     * @remark default implementation returns names sorted alphabetically
+     * @return application names
+     */
+    virtual QStringList order() const;
+
 public slots:
 
     /**
@@ -124,11 +150,40 @@ public slots:
      */
     void removeApplication(ApplicationItem *_item);
 
+signals:
+
+    /**
+     * @brief signal which will be emitted when application list has been
+     * changed
+     * @param _generation new generation number
+     * @param _added names of added applications
+     * @param _removed names of removed applications
+     * @param _order new application order if it has been changed, otherwise
+     * empty
+     */
+    void applicationsChanged(const uint _generation, const QStringList &_added,
+                             const QStringList &_removed,
+                             const QStringList &_order);
+
+protected:
+    /**
+     * @brief compare application list with previous one and emit
+     * applicationsChanged() if there are changes
+     * @remark order is taken from order(), thus it is sent if only order has
+     * been changed
+     * @param _previous value of order() before changes
+     */
+    void notifyChanges(const QStringList &_previous);
+
 private:
     /**
      * @brief list of applications
      */
     QMap<QString, ApplicationItem *> m_applications;
+    /**
+     * @brief current generation of application list
+     */
+    uint m_generation = 0;
 };
 };
 
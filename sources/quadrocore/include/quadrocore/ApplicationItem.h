@@ -26,12 +26,11 @@
 #ifndef APPLICATIONITEM_H
 #define APPLICATIONITEM_H
 
+#include <QIcon>
 #include <QObject>
 #include <QVariant>
 
 
-class QIcon;
-
 /**
  * @namespace Quadro
  */
@@ -276,6 +275,7 @@ public:
     // desktop methods
     /**
      * @brief application icon as QIcon object
+     * @remark icon files are resolved by IconThemeIndex
      * @return QIcon object associated with ApplicationItem::icon()
      */
     QIcon appIcon() const;
@@ -313,6 +313,15 @@ public:
     static ApplicationItem *fromDesktop(const QString &_desktopPath,
                                         QObject *_parent);
 
+    /**
+     * @brief read application information from properties
+     * @param _properties desktop entry properties as returned by toHash()
+     * @param _parent pointer to parent item
+     * @return ApplicationItem structure
+     */
+    static ApplicationItem *fromHash(const QVariantHash &_properties,
+                                     QObject *_parent);
+
     /**
      * @brief does application have specified substring or not
      * @param _substr substring for search
@@ -341,6 +350,13 @@ public:
      */
     bool startsWith(const QString &_substr) const;
 
+    /**
+     * @brief known desktop entry properties which are not empty
+     * @remark desktop file name is stored as DesktopName if it has been set
+     * @return map of property names to values
+     */
+    QVariantHash toHash() const;
+
 public slots:
 
     /**
@@ -402,6 +418,10 @@ private:
      * @brief application icon
      */
     QString m_icon = "system-run";
+    /**
+     * @brief icon object which is created on the first request
+     */
+    mutable QIcon m_appIcon;
     /**
      * @brief application keywords
      */
@@ -0,0 +1,126 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file CatalogueSnapshot.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+#ifndef CATALOGUESNAPSHOT_H
+#define CATALOGUESNAPSHOT_H
+
+#include <QObject>
+
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+class AbstractAppAggregator;
+
+class ApplicationItem;
+
+/**
+ * @brief The CatalogueSnapshot class provides read-only application catalogue
+ * published as sealed memory file
+ * @remark snapshot format, all numbers are 32-bit unsigned integers in host
+ * byte order:
+ *  - header: magic "QCAT", format version, generation, record count, records
+ *    offset, strings offset and strings size. Offsets are counted from the
+ *    beginning of the file
+ *  - records: 8 numbers per application, which are offsets inside string
+ *    table of name, generic name, comment, icon, executable, desktop name,
+ *    categories and keywords. Lists are joined by ";". Records are sorted by
+ *    application name
+ *  - strings: NUL-terminated UTF-8 strings, offset 0 is always empty string
+ * @note memory files are available on Linux only, on other platforms snapshot
+ * will not be published
+ */
+class CatalogueSnapshot : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief snapshot format version
+     */
+    static const quint32 VERSION = 1;
+
+    /**
+     * @brief CatalogueSnapshot class constructor
+     * @param _parent pointer to parent item
+     * @param _source pointer to application aggregator which will be exported
+     */
+    explicit CatalogueSnapshot(QObject *_parent,
+                               AbstractAppAggregator *_source);
+
+    /**
+     * @brief CatalogueSnapshot class destructor
+     */
+    virtual ~CatalogueSnapshot();
+
+    /**
+     * @brief file descriptor of the current snapshot
+     * @remark snapshot will be published again if source generation has been
+     * changed
+     * @return file descriptor or -1 if snapshot could not be published
+     */
+    int fileDescriptor();
+
+    /**
+     * @brief generation of the current snapshot
+     * @return generation of source at the moment of publication
+     */
+    uint generation() const;
+
+    /**
+     * @brief serialize applications into the snapshot format
+     * @param _items applications sorted by name
+     * @param _generation source generation
+     * @return binary snapshot data
+     */
+    static QByteArray serialize(const QList<ApplicationItem *> &_items,
+                                const uint _generation);
+
+private:
+    /**
+     * @brief file descriptor of the published snapshot
+     */
+    int m_fd = -1;
+    /**
+     * @brief generation of the published snapshot
+     */
+    uint m_generation = 0;
+    /**
+     * @brief pointer to the exported aggregator
+     */
+    AbstractAppAggregator *m_source = nullptr;
+    // methods
+    /**
+     * @brief create sealed memory file from the source
+     * @return file descriptor or -1 if an error occurs
+     */
+    int publish() const;
+};
+};
+
+
+#endif /* CATALOGUESNAPSHOT_H */
@@ -27,6 +27,7 @@
 #define CONFIGMANAGER_H
 
 #include <QObject>
+#include <QStringList>
 #include <QVariant>
 
 
@@ -45,7 +46,10 @@ class ConfigManager : public QObject
     Q_PROPERTY(QString path READ path)
     // configuration
     Q_PROPERTY(int GridSize READ gridSize)
+    Q_PROPERTY(QStringList IndexRoots READ indexRoots)
     Q_PROPERTY(int RecentItemsCount READ recentItemCount)
+    Q_PROPERTY(int SearchDepth READ searchDepth)
+    Q_PROPERTY(QStringList SearchExcludes READ searchExcludes)
 
 public:
     /**
@@ -92,12 +96,31 @@ public:
      */
     int gridSize() const;
 
+    /**
+     * @brief directories which are covered by file name index
+     * @return list of indexed directories, empty list means that index is
+     * disabled
+     */
+    QStringList indexRoots() const;
+
     /**
      * @brief maximum recently run application count to store
      * @return maximum count
      */
     int recentItemCount() const;
 
+    /**
+     * @brief maximal depth of file search
+     * @return search depth, -1 means no limit
+     */
+    int searchDepth() const;
+
+    /**
+     * @brief patterns which will be skipped during file search
+     * @return list of wildcard patterns
+     */
+    QStringList searchExcludes() const;
+
 public slots:
 
     /**
@@ -27,8 +27,13 @@
 #define DBUSOPERATIONS_H
 
 #include <QDBusArgument>
+#include <QDBusPendingCall>
 #include <QVariant>
 
+#include <functional>
+
+#include "Config.h"
+
 
 /**
  * @namespace Quadro
@@ -41,6 +46,12 @@ namespace Quadro
  */
 namespace DBusOperations
 {
+/**
+ * @brief callback which will be called on asynchronous DBus reply. It accepts
+ * reply arguments which will be empty in case of error
+ */
+typedef std::function<void(const QVariantList &)> ReplyHandler;
+
 /**
  * @brief additional method to avoid conversion from DBus type to native ones
  * @tparam T type to which DBus data should be converted
@@ -53,6 +64,17 @@ template <class T> T toNativeType(const QVariant _data)
         _data.value<QDBusVariant>().variant().value<QDBusArgument>());
 };
 
+/**
+ * @brief call handler when asynchronous DBus request will be finished
+ * @remark the handler will not be called if receiver has been destroyed
+ * before the reply arrived
+ * @param _call pending call object returned by asynchronous request
+ * @param _receiver object which controls handler lifetime
+ * @param _handler function which will be called with reply arguments
+ */
+void onReply(const QDBusPendingCall &_call, QObject *_receiver,
+             ReplyHandler _handler);
+
 /**
  * @brief common DBus request
  * @param _service DBus service name
@@ -60,11 +82,28 @@ template <class T> T toNativeType(const QVariant _data)
  * @param _interface DBus interface name
  * @param _cmd command which will be sent to DBus
  * @param _args command arguments
+ * @param _timeout call timeout in milliseconds, -1 means DBus default timeout
  * @return reply object from DBus request
  */
 QVariantList sendRequest(const QString &_service, const QString &_path,
                          const QString &_interface, const QString &_cmd,
-                         const QVariantList &_args);
+                         const QVariantList &_args, const int _timeout = -1);
+
+/**
+ * @brief common asynchronous DBus request
+ * @param _service DBus service name
+ * @param _path DBus object path
+ * @param _interface DBus interface name
+ * @param _cmd command which will be sent to DBus
+ * @param _args command arguments
+ * @param _timeout call timeout in milliseconds
+ * @return pending call object
+ */
+QDBusPendingCall sendRequestAsync(const QString &_service, const QString &_path,
+                                  const QString &_interface,
+                                  const QString &_cmd,
+                                  const QVariantList &_args,
+                                  const int _timeout = DBUS_TIMEOUT);
 
 /**
  * @brief DBus request to configuration manager
@@ -75,6 +114,18 @@ QVariantList sendRequest(const QString &_service, const QString &_path,
 QVariantList sendRequestToConfig(const QString &_cmd,
                                  const QVariantList &_args = QVariantList());
 
+/**
+ * @brief asynchronous DBus request to configuration manager
+ * @param _cmd command which will be sent to DBus
+ * @param _args command arguments if any
+ * @param _timeout call timeout in milliseconds
+ * @return DBusOperations::sendRequestAsync()
+ */
+QDBusPendingCall
+sendRequestToConfigAsync(const QString &_cmd,
+                         const QVariantList &_args = QVariantList(),
+                         const int _timeout = DBUS_TIMEOUT);
+
 /**
  * @brief DBus request to library
  * @param _cmd command which will be sent to DBus
@@ -84,6 +135,18 @@ QVariantList sendRequestToConfig(const QString &_cmd,
 QVariantList sendRequestToLibrary(const QString &_cmd,
                                   const QVariantList &_args = QVariantList());
 
+/**
+ * @brief asynchronous DBus request to library
+ * @param _cmd command which will be sent to DBus
+ * @param _args command arguments if any
+ * @param _timeout call timeout in milliseconds
+ * @return DBusOperations::sendRequestAsync()
+ */
+QDBusPendingCall
+sendRequestToLibraryAsync(const QString &_cmd,
+                          const QVariantList &_args = QVariantList(),
+                          const int _timeout = DBUS_TIMEOUT);
+
 /**
  * @brief DBus request to plugin
  * @param _index plugin index
@@ -94,6 +157,19 @@ QVariantList sendRequestToLibrary(const QString &_cmd,
 QVariantList sendRequestToPlugin(const int _index, const QString &_cmd,
                                  const QVariantList &_args = QVariantList());
 
+/**
+ * @brief asynchronous DBus request to plugin
+ * @param _index plugin index
+ * @param _cmd command which will be sent to DBus
+ * @param _args command arguments if any
+ * @param _timeout call timeout in milliseconds
+ * @return DBusOperations::sendRequestAsync()
+ */
+QDBusPendingCall
+sendRequestToPluginAsync(const int _index, const QString &_cmd,
+                         const QVariantList &_args = QVariantList(),
+                         const int _timeout = DBUS_TIMEOUT);
+
 /**
  * @brief DBus request to ui
  * @param _cmd command which will be sent to DBus
@@ -102,6 +178,18 @@ QVariantList sendRequestToPlugin(const int _index, const QString &_cmd,
  */
 QVariantList sendRequestToUi(const QString &_cmd,
                              const QVariantList &_args = QVariantList());
+
+/**
+ * @brief asynchronous DBus request to ui
+ * @param _cmd command which will be sent to DBus
+ * @param _args command arguments if any
+ * @param _timeout call timeout in milliseconds
+ * @return DBusOperations::sendRequestAsync()
+ */
+QDBusPendingCall sendRequestToUiAsync(const QString &_cmd,
+                                      const QVariantList &_args
+                                      = QVariantList(),
+                                      const int _timeout = DBUS_TIMEOUT);
 };
 };
 
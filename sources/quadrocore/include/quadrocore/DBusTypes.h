@@ -0,0 +1,166 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file DBusTypes.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef DBUSTYPES_H
+#define DBUSTYPES_H
+
+#include <QDBusArgument>
+#include <QStringList>
+
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief application metadata which is used in DBus replies
+ * @remark DBus signature is (ssssssasas)
+ */
+struct ApplicationMetadata {
+    /**
+     * @brief application name
+     */
+    QString name;
+    /**
+     * @brief application generic name
+     */
+    QString genericName;
+    /**
+     * @brief application comment
+     */
+    QString comment;
+    /**
+     * @brief application icon name
+     */
+    QString icon;
+    /**
+     * @brief application executable
+     */
+    QString exec;
+    /**
+     * @brief application desktop file name
+     */
+    QString desktopName;
+    /**
+     * @brief application categories
+     */
+    QStringList categories;
+    /**
+     * @brief application keywords
+     */
+    QStringList keywords;
+};
+
+/**
+ * @brief plugin metadata which is used in DBus replies
+ * @remark DBus signature is (sssssss)
+ */
+struct PluginMetadata {
+    /**
+     * @brief plugin author
+     */
+    QString author;
+    /**
+     * @brief plugin comment
+     */
+    QString comment;
+    /**
+     * @brief plugin group
+     */
+    QString group;
+    /**
+     * @brief plugin location
+     */
+    QString location;
+    /**
+     * @brief plugin name
+     */
+    QString name;
+    /**
+     * @brief plugin homepage
+     */
+    QString url;
+    /**
+     * @brief plugin version
+     */
+    QString version;
+};
+
+/**
+ * @brief marshall application metadata to DBus argument
+ * @param _argument DBus argument
+ * @param _metadata source metadata
+ * @return DBus argument
+ */
+QDBusArgument &operator<<(QDBusArgument &_argument,
+                          const ApplicationMetadata &_metadata);
+/**
+ * @brief demarshall application metadata from DBus argument
+ * @param _argument DBus argument
+ * @param _metadata target metadata
+ * @return DBus argument
+ */
+const QDBusArgument &operator>>(const QDBusArgument &_argument,
+                                ApplicationMetadata &_metadata);
+/**
+ * @brief marshall plugin metadata to DBus argument
+ * @param _argument DBus argument
+ * @param _metadata source metadata
+ * @return DBus argument
+ */
+QDBusArgument &operator<<(QDBusArgument &_argument,
+                          const PluginMetadata &_metadata);
+/**
+ * @brief demarshall plugin metadata from DBus argument
+ * @param _argument DBus argument
+ * @param _metadata target metadata
+ * @return DBus argument
+ */
+const QDBusArgument &operator>>(const QDBusArgument &_argument,
+                                PluginMetadata &_metadata);
+
+/**
+ * @namespace DBusTypes
+ * @brief methods provide registration of custom DBus types
+ */
+namespace DBusTypes
+{
+/**
+ * @brief register custom types in Qt meta type and DBus type systems. It
+ * should be called before any object which uses them will be exported
+ */
+void registerTypes();
+};
+};
+
+Q_DECLARE_METATYPE(Quadro::ApplicationMetadata)
+Q_DECLARE_METATYPE(QList<Quadro::ApplicationMetadata>)
+Q_DECLARE_METATYPE(Quadro::PluginMetadata)
+Q_DECLARE_METATYPE(QList<Quadro::PluginMetadata>)
+
+
+#endif /* DBUSTYPES_H */
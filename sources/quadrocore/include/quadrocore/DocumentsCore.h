@@ -28,16 +28,26 @@
 
 #include <QDateTime>
 #include <QMap>
+#include <QSet>
 #include <QStringList>
 
 #include "AbstractAppAggregator.h"
 
 
+class QThreadPool;
+
+
 /**
  * @namespace Quadro
  */
 namespace Quadro
 {
+class ItemStorage;
+
+class MimeResolver;
+
+class XbelReader;
+
 /**
  * @brief The DocumentsCore class provides backend for recently documents
  * @remark there is a draft of standard
@@ -63,31 +73,59 @@ public:
 
     /**
      * @brief path to desktop files
+     * @remark desktop files are used as legacy layout which is imported to
+     * the storage on the first run
      * @return full path to desktop files
      */
     static QString desktopPath();
 
     /**
-     * @brief return applications which has desktop files
+     * @brief return applications which are stored in the storage
      * @return map of generated ApplicationItem
      */
     QMap<QString, ApplicationItem *> getApplicationsFromDesktops();
 
+    /**
+     * @brief application names sorted by modification time
+     * @return application names, the most recent is the last
+     */
+    QStringList order() const;
+
     /**
      * @brief get recently run applications
-     * @return application names
+     * @return application names sorted by modification time
      */
     QStringList recent() const;
 
+    /**
+     * @brief items storage
+     * @return pointer to items storage
+     */
+    ItemStorage *storage() const;
+
+    /**
+     * @brief set MIME type resolver which is used for icon resolution
+     * @param _mime pointer to shared MIME type resolver
+     */
+    void setMimeResolver(MimeResolver *_mime);
+
 public slots:
 
     /**
      * @brief add item to recent run by its name
+     * @remark item is added without icon, it will be resolved by
+     * resolveIcons() call once item is going to be shown
      * @param _name recent application name
      * @return pointer to created ApplicationItem
      */
     ApplicationItem *addItem(const QString &_name);
 
+    /**
+     * @brief import documents which have been added to recently used
+     * bookmarks since the last import
+     */
+    void importBookmarks();
+
     /**
      * @brief init application using given paths
      */
@@ -99,21 +137,65 @@ public slots:
      */
     void removeItemByName(const QString &_name);
 
+    /**
+     * @brief resolve icons of items which do not have them yet. This method
+     * should be called when items are going to be shown. Icons are resolved
+     * in background, itemChanged() will be emitted for each resolved item
+     * @param _names item names
+     */
+    void resolveIcons(const QStringList &_names);
+
     /**
      * @brief touch application on new run
      * @param _name name if application item
      */
     void touchItem(const QString &_name);
 
+signals:
+    /**
+     * @brief signal which will be emitted when item properties have been
+     * changed
+     * @param _name item name
+     */
+    void itemChanged(const QString &_name);
+
+private slots:
+    /**
+     * @brief set resolved icon to item
+     * @param _name item name
+     * @param _icon icon name
+     */
+    void setItemIcon(const QString &_name, const QString &_icon);
+
 private:
     /**
      * @brief list of loaded applications sorted by modification times
      */
     QStringList m_modifications;
+    /**
+     * @brief MIME type resolver
+     */
+    MimeResolver *m_mime = nullptr;
+    /**
+     * @brief items which icons are being resolved now
+     */
+    QSet<QString> m_pending;
+    /**
+     * @brief thread pool for icon resolution
+     */
+    QThreadPool *m_pool = nullptr;
     /**
      * @brief max recent items count
      */
     int m_recentItems;
+    /**
+     * @brief items storage
+     */
+    ItemStorage *m_storage = nullptr;
+    /**
+     * @brief recently used bookmarks reader
+     */
+    XbelReader *m_bookmarks = nullptr;
 
     /**
      * @brief rotate application data information
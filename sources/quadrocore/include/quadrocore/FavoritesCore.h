@@ -28,6 +28,8 @@
 
 #include <QMap>
 #include <QObject>
+#include <QSet>
+#include <QTimer>
 
 
 /**
@@ -37,6 +39,8 @@ namespace Quadro
 {
 class ApplicationItem;
 
+class ItemStorage;
+
 /**
  * @brief The FavoritesCore class provides favorites backend
  */
@@ -71,6 +75,8 @@ public:
 
     /**
      * @brief add or remove application to the favorites items
+     * @remark shared instance will be used if any, otherwise temporary one will
+     * be created
      * @param _item pointer to application item object
      * @return application item
      */
@@ -92,22 +98,28 @@ public:
      * @param _item pointer to application item object
      * @return true if application is in favorites otherwise returns false
      */
-    bool check(ApplicationItem *_item);
+    bool check(ApplicationItem *_item) const;
 
     /**
      * @brief path to desktop files
+     * @remark desktop files are used as legacy layout which is imported to
+     * the storage on the first run
      * @return full path to desktop files
      */
     static QString desktopPath();
 
     /**
-     * @brief return applications which has desktop files
-     * @return map of generated ApplicationItem
+     * @brief current generation of favorites list
+     * @remark generation is increased each time when favorites list or its
+     * order has been changed
+     * @return generation number
      */
-    QMap<QString, ApplicationItem *> getApplicationsFromDesktops();
+    uint generation() const;
 
     /**
      * @brief check whether the application in favorites
+     * @remark shared instance will be used if any, otherwise temporary one will
+     * be created
      * @param _item pointer to application item object
      * @return true if application is in favorites otherwise returns false
      */
@@ -115,20 +127,41 @@ public:
 
     /**
      * @brief path to index file
+     * @remark index file is used as legacy layout
      * @return full path to index file
      */
     static QString indexPath();
 
+    /**
+     * @brief shared favorites instance
+     * @return pointer to shared instance or nullptr if it has not been set
+     */
+    static FavoritesCore *instance();
+
     /**
      * @brief application order
      * @return list of applications by name
      */
     QStringList order() const;
 
+    /**
+     * @brief set shared favorites instance which will be used by static
+     * methods. Instance will be reset automatically on its destruction
+     * @param _instance pointer to favorites instance
+     */
+    static void setInstance(FavoritesCore *_instance);
+
+    /**
+     * @brief items storage
+     * @return pointer to items storage
+     */
+    ItemStorage *storage() const;
+
 public slots:
 
     /**
      * @brief move given application up or down
+     * @remark order will be saved after @ref FAVORITES_SAVE_DELAY
      * @param _name desktop name
      * @param _up move application up, default is true
      */
@@ -140,19 +173,57 @@ public slots:
     void initApplications();
 
     /**
-     * @brief save current application order to the index file
+     * @brief move given application to the specified position
+     * @remark order will be saved after @ref FAVORITES_SAVE_DELAY
+     * @param _name desktop name
+     * @param _index new application index
+     */
+    void moveApplication(const QString &_name, const int _index);
+
+    /**
+     * @brief save current application order to the storage immediately
      */
     void saveApplicationsOrder() const;
 
+signals:
+
+    /**
+     * @brief signal which will be emitted when favorites have been changed
+     * @param _generation new generation number
+     * @param _added names of added applications
+     * @param _removed names of removed applications
+     * @param _order new application order if it has been changed, otherwise
+     * empty
+     */
+    void applicationsChanged(const uint _generation, const QStringList &_added,
+                             const QStringList &_removed,
+                             const QStringList &_order);
+
 private:
     /**
      * @brief list of applications
      */
     QMap<QString, ApplicationItem *> m_applications;
+    /**
+     * @brief names of applications for fast lookup
+     */
+    QSet<QString> m_names;
     /**
      * @brief order of applications
      */
     QStringList m_order;
+    /**
+     * @brief items storage
+     */
+    ItemStorage *m_storage = nullptr;
+    /**
+     * @brief timer which is used to save order after reorder
+     */
+    QTimer m_saveTimer;
+    /**
+     * @brief current generation of favorites list
+     */
+    uint m_generation = 0;
 
     /**
      * @brief add application to favorites
@@ -161,10 +232,11 @@ private:
     void addAppToFavorites(ApplicationItem *_item);
 
     /**
-     * @brief return correct applications order
-     * @return list of applications in the correct order
+     * @brief compare favorites with previous state and emit
+     * applicationsChanged() if there are changes
+     * @param _previous application order before changes
      */
-    QStringList getApplicationsOrder() const;
+    void notifyChanges(const QStringList &_previous);
 
     /**
      * @brief remove application from favorites
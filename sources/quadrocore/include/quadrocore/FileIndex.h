@@ -0,0 +1,364 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file FileIndex.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef FILEINDEX_H
+#define FILEINDEX_H
+
+#include <QAtomicInt>
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+
+class QSocketNotifier;
+class QThreadPool;
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The FileIndex class provides file name index of configured roots
+ * @remark the index is built in background on each start and kept up to date
+ * by inotify, created directories are scanned in background as well. Saved
+ * index is loaded before the build, thus it may be used while the actual
+ * index is being built. File names are indexed by lower case trigrams,
+ * substrings shorter than three characters are checked against all names.
+ * Symbolic links are not followed and other filesystems are not indexed
+ */
+class FileIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief FileIndex class constructor
+     * @param _parent pointer to parent object
+     */
+    explicit FileIndex(QObject *_parent);
+
+    /**
+     * @brief FileIndex class destructor
+     */
+    virtual ~FileIndex();
+
+    /**
+     * @brief check whether directory is covered by the index
+     * @param _directory path to directory
+     * @return true if index is ready and directory is inside indexed roots
+     */
+    bool covers(const QString &_directory) const;
+
+    /**
+     * @brief path to saved index
+     * @return full path to index file
+     */
+    static QString indexPath();
+
+    /**
+     * @brief indexed roots
+     * @return list of root directories
+     */
+    QStringList roots() const;
+
+    /**
+     * @brief find entries by substring
+     * @param _directory parent directory, it should be covered by the index
+     * @param _substr substring for name, see FileSystemWalker::nameMatcher()
+     * @param _hidden show hidden files or not
+     * @param _excludes exclude patterns, see FileSystemWalker::setExcludes()
+     * @param _maxDepth maximal search depth, -1 means no limit
+     * @return list of found entries in arbitrary order
+     */
+    QFileInfoList search(const QString &_directory, const QString &_substr,
+                         const bool _hidden, const QStringList &_excludes,
+                         const int _maxDepth) const;
+
+    /**
+     * @brief set indexed roots
+     * @remark empty list disables the index
+     * @param _roots list of root directories
+     */
+    void setRoots(const QStringList &_roots);
+
+signals:
+    /**
+     * @brief signal which will be emitted when background build has been
+     * finished
+     */
+    void ready();
+
+public slots:
+    /**
+     * @brief rebuild index in background
+     */
+    void rebuild();
+
+    /**
+     * @brief save index to file
+     * @return true if index has been saved
+     */
+    bool save() const;
+
+private slots:
+    /**
+     * @brief apply built index
+     */
+    void applyBuild();
+
+    /**
+     * @brief merge directories scanned in background into index
+     */
+    void applyScan();
+
+    /**
+     * @brief read inotify events
+     */
+    void readEvents();
+
+private:
+    /**
+     * @brief index entry
+     */
+    struct Entry {
+        /**
+         * @brief parent entry index, -1 for roots
+         */
+        int parent;
+        /**
+         * @brief file name, absolute path for roots
+         */
+        QString name;
+        /**
+         * @brief is entry directory or not
+         */
+        bool directory;
+        /**
+         * @brief is entry removed or not
+         */
+        bool removed;
+    };
+    /**
+     * @brief index data
+     */
+    struct Tree {
+        /**
+         * @brief entries, parent is always placed before its children
+         */
+        QVector<Entry> entries;
+        /**
+         * @brief entry indices by name trigram
+         */
+        QHash<quint64, QVector<int>> trigrams;
+        /**
+         * @brief child entry indices by name for each parent entry
+         */
+        QHash<int, QHash<QString, int>> children;
+        /**
+         * @brief inotify file descriptor, -1 if there is no one
+         */
+        int fd = -1;
+        /**
+         * @brief directory entry indices by watch descriptor
+         */
+        QHash<int, int> watches;
+    };
+    /**
+     * @brief inotify event
+     */
+    struct Event {
+        /**
+         * @brief watch descriptor
+         */
+        int wd;
+        /**
+         * @brief event mask
+         */
+        quint32 mask;
+        /**
+         * @brief entry name, empty for watched directory itself
+         */
+        QString name;
+    };
+    /**
+     * @brief directory scanned in background
+     */
+    struct Scan {
+        /**
+         * @brief index generation for which directory has been scanned
+         */
+        int generation;
+        /**
+         * @brief directory entry index
+         */
+        int index;
+        /**
+         * @brief scanned entries, the directory itself is the first one,
+         * nullptr if scan has been cancelled
+         */
+        Tree *tree;
+    };
+    /**
+     * @brief build cancellation flag
+     */
+    QAtomicInt m_cancelled;
+    /**
+     * @brief events of watches which have not been merged yet
+     */
+    QList<Event> m_deferred;
+    /**
+     * @brief index generation, it is increased each time when index data
+     * has been replaced
+     */
+    int m_generation = 0;
+    /**
+     * @brief built index which is waiting to be applied
+     */
+    Tree *m_pending = nullptr;
+    /**
+     * @brief lock of built index and scanned directories
+     */
+    QMutex m_pendingLock;
+    /**
+     * @brief inotify notifier
+     */
+    QSocketNotifier *m_notifier = nullptr;
+    /**
+     * @brief thread pool for index build
+     */
+    QThreadPool *m_pool = nullptr;
+    /**
+     * @brief is index ready to use or not
+     */
+    bool m_ready = false;
+    /**
+     * @brief indexed roots
+     */
+    QStringList m_roots;
+    /**
+     * @brief directories scanned in background which are waiting to be
+     * merged
+     */
+    QList<Scan> m_scanned;
+    /**
+     * @brief count of queued directory scans
+     */
+    int m_scans = 0;
+    /**
+     * @brief index save timer
+     */
+    QTimer m_saveTimer;
+    /**
+     * @brief current index data
+     */
+    Tree m_tree;
+    // methods
+    /**
+     * @brief append entry to index
+     * @param _tree index data
+     * @param _parent parent entry index
+     * @param _name entry name
+     * @param _directory is entry directory or not
+     * @return index of new entry
+     */
+    static int append(Tree &_tree, const int _parent, const QString &_name,
+                      const bool _directory);
+    /**
+     * @brief find entries which names may contain substring
+     * @param _tree index data
+     * @param _substr lower case substring
+     * @return list of entry indices
+     */
+    static QVector<int> candidates(const Tree &_tree, const QString &_substr);
+    /**
+     * @brief clear index data and close its inotify descriptor
+     * @param _tree index data
+     */
+    static void clear(Tree &_tree);
+    /**
+     * @brief find child entry by name
+     * @param _parent parent entry index
+     * @param _name entry name
+     * @return entry index or -1 if nothing found
+     */
+    int find(const int _parent, const QString &_name) const;
+    /**
+     * @brief load saved index
+     * @return true if index for current roots has been loaded
+     */
+    bool load();
+    /**
+     * @brief append scanned directory entries to index
+     * @param _tree scanned directory data
+     * @param _index directory entry index in current index
+     */
+    void merge(const Tree &_tree, const int _index);
+    /**
+     * @brief absolute path of entry
+     * @param _index entry index
+     * @return path or empty string if entry or any its parent has been removed
+     */
+    QString path(const int _index) const;
+    /**
+     * @brief apply inotify event to index
+     * @remark events of unknown watches are deferred while there are queued
+     * directory scans
+     * @param _event inotify event
+     * @return true if index has been changed
+     */
+    bool processEvent(const Event &_event);
+    /**
+     * @brief read directory tree and append its entries to index
+     * @param _tree index data
+     * @param _index directory entry index
+     * @param _path absolute directory path
+     * @param _cancelled cancellation flag if any
+     */
+    static void scan(Tree &_tree, const int _index, const QString &_path,
+                     const QAtomicInt *_cancelled = nullptr);
+    /**
+     * @brief queue directory scan in background
+     * @param _index directory entry index
+     * @param _path absolute directory path
+     */
+    void scanDirectory(const int _index, const QString &_path);
+    /**
+     * @brief name trigrams
+     * @param _name lower case name
+     * @return list of unique trigrams
+     */
+    static QList<quint64> trigrams(const QString &_name);
+};
+};
+
+
+#endif /* FILEINDEX_H */
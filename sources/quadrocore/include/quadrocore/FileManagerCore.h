@@ -26,18 +26,30 @@
 #ifndef FILEMANAGERCORE_H
 #define FILEMANAGERCORE_H
 
+#include <QAtomicInt>
 #include <QFileInfo>
+#include <QHash>
+#include <QMimeDatabase>
 #include <QObject>
+#include <QSharedPointer>
 
 
 class QIcon;
-class QMimeType;
+class QThreadPool;
 
 /**
  * @namespace Quadro
  */
 namespace Quadro
 {
+class FileIndex;
+
+class FileSystemWalker;
+
+class MimeAppsIndex;
+
+class MimeResolver;
+
 /**
  * @brief The FileManager class provides file manager backend
  */
@@ -59,6 +71,8 @@ public:
 
     /**
      * @brief find directory entries
+     * @remark this method blocks until all entries are read, consider
+     * listDirectory() for large directories
      * @param _directory path to directory on which you are looking for
      * @param _hidden show hidden files or not
      * @param _filter name filter
@@ -70,46 +84,211 @@ public:
 
     /**
      * @brief find entries by substring
+     * @remark if directory is covered by file name index the result will be
+     * returned from the index, otherwise this method blocks until the whole
+     * tree is walked, consider searchEntries() for interactive search
      * @param _directory parent directory
-     * @param _substr substring for name
+     * @param _substr substring for name, it may contain wildcards
      * @param _hidden show hidden files or not
+     * @return list of found entries in arbitrary order
      */
     QFileInfoList entriesBySubstr(const QString &_directory,
                                   const QString &_substr,
                                   const bool _hidden = false) const;
 
+    /**
+     * @brief file name index
+     * @return pointer to file name index
+     */
+    FileIndex *index() const;
+
+    /**
+     * @brief shared MIME type resolver
+     * @return pointer to MIME type resolver
+     */
+    MimeResolver *mimeResolver() const;
+
+    /**
+     * @brief set MIME type associations which are used by openFile()
+     * @param _associations pointer to associations index
+     */
+    void setAssociations(MimeAppsIndex *_associations);
+
+    /**
+     * @brief set file name index roots
+     * @param _roots list of indexed directories, empty list disables index
+     */
+    void setIndexRoots(const QStringList &_roots);
+
+    /**
+     * @brief set search rules which are used by entriesBySubstr() and
+     * searchEntries()
+     * @param _excludes exclude patterns, see FileSystemWalker::setExcludes()
+     * @param _maxDepth maximal search depth, -1 means no limit
+     */
+    void setSearchRules(const QStringList &_excludes, const int _maxDepth);
+
     /**
      * @brief get icon by file name
      * @param _file path to file
+     * @param _mode MIME type detection mode
      * @return QIcon of the file
      */
-    QIcon iconByFileName(const QString &_file) const;
+    QIcon iconByFileName(const QString &_file,
+                         const QMimeDatabase::MatchMode _mode
+                         = QMimeDatabase::MatchDefault) const;
 
     /**
      * @brief get icon name by file name
      * @param _file path to file
+     * @param _mode MIME type detection mode
      * @return icon name
      */
-    QString iconNameByFileName(const QString &_file) const;
+    QString iconNameByFileName(const QString &_file,
+                               const QMimeDatabase::MatchMode _mode
+                               = QMimeDatabase::MatchDefault) const;
+
+    /**
+     * @brief get icon names by file names
+     * @remark file content is not read by default since this method is
+     * used for listings
+     * @param _files paths to files
+     * @param _mode MIME type detection mode
+     * @return list of icon names in the same order as files
+     */
+    QStringList iconNamesByFileNames(const QStringList &_files,
+                                     const QMimeDatabase::MatchMode _mode
+                                     = QMimeDatabase::MatchExtension) const;
 
     /**
      * @brief get mime type of given file
      * @param _file path to file
+     * @param _mode MIME type detection mode
      * @return QMimeType construction
      */
-    QMimeType mimeByFileName(const QString &_file) const;
+    QMimeType mimeByFileName(const QString &_file,
+                             const QMimeDatabase::MatchMode _mode
+                             = QMimeDatabase::MatchDefault) const;
+
+    /**
+     * @brief get mime types of given files
+     * @remark file content is not read by default since this method is
+     * used for listings
+     * @param _files paths to files
+     * @param _mode MIME type detection mode
+     * @return list of QMimeType in the same order as files
+     */
+    QList<QMimeType> mimesByFileNames(const QStringList &_files,
+                                      const QMimeDatabase::MatchMode _mode
+                                      = QMimeDatabase::MatchExtension) const;
 
 public slots:
 
     /**
-     * @brief open file using XDG
+     * @brief cancel directory listing or search. Chunks which have been
+     * already sent may still be received
+     * @param _id request id returned by listDirectory() or searchEntries()
+     */
+    void cancelRequest(const int _id);
+
+    /**
+     * @brief list directory entries in background
+     * @remark entries are sent by entriesReceived() signal in chunks of
+     * @ref FILEMANAGER_CHUNK_SIZE items in directory order, they are not
+     * sorted. listingFinished() will be emitted at the end
+     * @param _directory path to directory
+     * @param _hidden show hidden files or not
+     * @param _filter name filter
+     * @return request id or -1 if directory does not exist
+     */
+    int listDirectory(const QString &_directory, const bool _hidden = false,
+                      const QStringList &_filter = {});
+
+    /**
+     * @brief open file using default application
+     * @remark the default application is launched directly if it is known
+     * from associations, otherwise file is opened using XDG
      * @param _file QFileInfo of given file
      * @return true if opening successfully
      * @return false if an error occurs
      */
     bool openFile(const QFileInfo &_file) const;
 
+    /**
+     * @brief find entries by substring in background
+     * @remark entries are sent by entriesReceived() signal in chunks, they
+     * are not sorted. listingFinished() will be emitted at the end. Search
+     * does not leave filesystem of the directory and does not follow
+     * symbolic links
+     * @param _directory parent directory
+     * @param _substr substring for name, it may contain wildcards
+     * @param _hidden show hidden files or not
+     * @return request id or -1 if directory does not exist
+     */
+    int searchEntries(const QString &_directory, const QString &_substr,
+                      const bool _hidden = false);
+
+signals:
+    /**
+     * @brief signal which will be emitted when next chunk of directory
+     * entries has been read
+     * @param _id request id
+     * @param _entries directory entries
+     */
+    void entriesReceived(const int _id, const QFileInfoList &_entries);
+
+    /**
+     * @brief signal which will be emitted when directory listing has been
+     * finished
+     * @param _id request id
+     * @param _cancelled true if request has been cancelled
+     */
+    void listingFinished(const int _id, const bool _cancelled);
+
+private slots:
+    /**
+     * @brief remove finished request
+     * @param _id request id
+     */
+    void removeRequest(const int _id);
+
 private:
+    /**
+     * @brief MIME type associations, may be nullptr
+     */
+    MimeAppsIndex *m_associations = nullptr;
+    /**
+     * @brief MIME type resolver shared between requests
+     */
+    MimeResolver *m_mime = nullptr;
+    /**
+     * @brief search exclude patterns
+     */
+    QStringList m_excludes;
+    /**
+     * @brief file name index
+     */
+    FileIndex *m_index = nullptr;
+    /**
+     * @brief last used request id
+     */
+    int m_lastRequest = 0;
+    /**
+     * @brief thread pool for directory listing
+     */
+    QThreadPool *m_pool = nullptr;
+    /**
+     * @brief cancellation flags of active requests
+     */
+    QHash<int, QSharedPointer<QAtomicInt>> m_requests;
+    /**
+     * @brief maximal search depth
+     */
+    int m_searchDepth = -1;
+    /**
+     * @brief active search requests
+     */
+    QHash<int, FileSystemWalker *> m_walkers;
 };
 };
 
@@ -0,0 +1,232 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file FileSystemWalker.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef FILESYSTEMWALKER_H
+#define FILESYSTEMWALKER_H
+
+#include <QAtomicInt>
+#include <QFileInfo>
+#include <QMutex>
+#include <QObject>
+#include <QRegExp>
+#include <QWaitCondition>
+
+#include <deque>
+
+
+class QThreadPool;
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The FileSystemWalker class provides parallel recursive search of
+ * entries by name substring
+ * @remark each thread has own queue of directories: it takes the newest
+ * directory from its own queue and steals the oldest one from other queues if
+ * its queue is empty. Symbolic links to directories are not followed
+ */
+class FileSystemWalker : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief FileSystemWalker class constructor
+     * @param _parent pointer to parent item
+     * @param _id request id which will be passed to signals
+     * @param _directory root directory
+     * @param _substr substring for name, case insensitive, it may contain
+     * wildcards
+     * @param _hidden show hidden files or not
+     */
+    explicit FileSystemWalker(QObject *_parent, const int _id,
+                              const QString &_directory,
+                              const QString &_substr, const bool _hidden);
+
+    /**
+     * @brief FileSystemWalker class destructor
+     */
+    virtual ~FileSystemWalker();
+
+    /**
+     * @brief matcher of entry names
+     * @param _substr substring for name, it may contain wildcards
+     * @return case insensitive wildcard pattern *substr*
+     */
+    static QRegExp nameMatcher(const QString &_substr);
+
+    /**
+     * @brief paths which are never walked into
+     * @return list of absolute paths
+     */
+    static QStringList prunedPaths();
+
+    /**
+     * @brief set names or paths which should be skipped
+     * @param _excludes list of wildcard patterns. If pattern contains / it will
+     * be matched against absolute path, otherwise against entry name
+     */
+    void setExcludes(const QStringList &_excludes);
+
+    /**
+     * @brief set maximal depth
+     * @param _depth maximal depth, -1 means no limit
+     */
+    void setMaxDepth(const int _depth);
+
+    /**
+     * @brief set whether other filesystems should be skipped
+     * @param _sameFilesystem do not walk into other filesystems if true
+     */
+    void setSameFilesystem(const bool _sameFilesystem);
+
+    /**
+     * @brief wait until search will be finished
+     */
+    void wait();
+
+public slots:
+    /**
+     * @brief stop search as soon as possible
+     */
+    void cancel();
+
+    /**
+     * @brief start search
+     */
+    void start();
+
+signals:
+    /**
+     * @brief signal which will be emitted when next chunk of entries has been
+     * found. It is emitted from worker threads
+     * @param _id request id
+     * @param _entries found entries
+     */
+    void entriesFound(const int _id, const QFileInfoList &_entries);
+
+    /**
+     * @brief signal which will be emitted when search has been finished
+     * @param _id request id
+     * @param _cancelled true if search has been cancelled
+     */
+    void finished(const int _id, const bool _cancelled);
+
+private:
+    /**
+     * @brief queue of directories of the single worker
+     */
+    struct WorkQueue {
+        /**
+         * @brief directories with their depth
+         */
+        std::deque<QPair<QByteArray, int>> directories;
+        /**
+         * @brief queue lock
+         */
+        QMutex lock;
+    };
+    /**
+     * @brief count of active workers
+     */
+    QAtomicInt m_active;
+    /**
+     * @brief cancellation flag
+     */
+    QAtomicInt m_cancelled;
+    /**
+     * @brief device of root directory
+     */
+    quint64 m_device = 0;
+    /**
+     * @brief root directory
+     */
+    QString m_directory;
+    /**
+     * @brief exclude patterns
+     */
+    QStringList m_excludes;
+    /**
+     * @brief show hidden files or not
+     */
+    bool m_hidden = false;
+    /**
+     * @brief request id
+     */
+    int m_id = -1;
+    /**
+     * @brief maximal depth
+     */
+    int m_maxDepth = -1;
+    /**
+     * @brief count of directories which are queued or being read
+     */
+    QAtomicInt m_pending;
+    /**
+     * @brief worker threads
+     */
+    QThreadPool *m_pool = nullptr;
+    /**
+     * @brief queues of workers
+     */
+    QList<WorkQueue *> m_queues;
+    /**
+     * @brief skip other filesystems or not
+     */
+    bool m_sameFilesystem = true;
+    /**
+     * @brief name substring, it may contain wildcards
+     */
+    QString m_substr;
+    /**
+     * @brief condition which is used to wake up idle workers
+     */
+    QWaitCondition m_wakeUp;
+    /**
+     * @brief lock for idle workers
+     */
+    QMutex m_wakeUpLock;
+    // methods
+    /**
+     * @brief take next directory
+     * @param _index worker index
+     * @param _directory found directory and its depth
+     * @return true if directory has been found otherwise returns false
+     */
+    bool takeDirectory(const int _index, QPair<QByteArray, int> &_directory);
+    /**
+     * @brief worker loop
+     * @param _index worker index
+     */
+    void work(const int _index);
+};
+};
+
+
+#endif /* FILESYSTEMWALKER_H */
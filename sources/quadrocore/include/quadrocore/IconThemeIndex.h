@@ -0,0 +1,240 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file IconThemeIndex.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef ICONTHEMEINDEX_H
+#define ICONTHEMEINDEX_H
+
+#include <QHash>
+#include <QIcon>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+
+
+class QFile;
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The IconThemeIndex class provides icon lookup by memory mapped
+ * theme indexes
+ * @remark GTK icon-theme.cache files are used if they are newer than theme
+ * directories. Otherwise index in the same format is generated once and saved
+ * to user cache directory. Inherited themes and hicolor are looked up as well
+ * as /usr/share/pixmaps. Index is immutable after creation, thus its methods
+ * are thread-safe
+ */
+class IconThemeIndex
+{
+public:
+    /**
+     * @brief IconThemeIndex class constructor
+     * @param _theme icon theme name
+     * @param _searchPaths icon theme paths
+     */
+    explicit IconThemeIndex(const QString &_theme,
+                            const QStringList &_searchPaths);
+
+    /**
+     * @brief IconThemeIndex class destructor
+     */
+    virtual ~IconThemeIndex();
+
+    /**
+     * @brief shared index
+     * @remark there is an index for each theme and paths, it is created on
+     * the first request. This method is thread-safe
+     * @param _theme icon theme name
+     * @param _searchPaths icon theme paths
+     * @return pointer to index
+     */
+    static QSharedPointer<IconThemeIndex>
+    instance(const QString &_theme, const QStringList &_searchPaths);
+
+    /**
+     * @brief shared index of the current theme
+     * @remark this method should be called from GUI thread only
+     * @return pointer to index
+     */
+    static QSharedPointer<IconThemeIndex> instance();
+
+    /**
+     * @brief create icon object
+     * @remark all icon sizes from the most suitable theme are added to the
+     * icon, falls back to QIcon::fromTheme() if icon could not be found.
+     * Icon name is kept, thus QIcon::name() returns the requested name
+     * @param _name icon name or absolute path to icon file
+     * @return icon object
+     */
+    QIcon icon(const QString &_name) const;
+
+    /**
+     * @brief find icon file
+     * @param _name icon name
+     * @param _size required icon size in pixels
+     * @return path to the most suitable icon file or empty string if nothing
+     * found
+     */
+    QString lookup(const QString &_name, const int _size) const;
+
+    /**
+     * @brief theme name
+     * @return icon theme name
+     */
+    QString theme() const;
+
+private:
+    /**
+     * @brief icon directory
+     */
+    struct Directory {
+        /**
+         * @brief absolute path to directory
+         */
+        QString path;
+        /**
+         * @brief nominal icon size
+         */
+        int size;
+        /**
+         * @brief minimal size which may be rendered without scaling
+         */
+        int minSize;
+        /**
+         * @brief maximal size which may be rendered without scaling
+         */
+        int maxSize;
+        /**
+         * @brief true if directory contains vector icons
+         */
+        bool scalable;
+    };
+    /**
+     * @brief memory mapped theme index
+     */
+    struct Cache {
+        /**
+         * @brief theme rank, the lower value is preferred
+         */
+        int rank;
+        /**
+         * @brief pointer to mapped data
+         */
+        const uchar *data;
+        /**
+         * @brief size of mapped data
+         */
+        quint32 size;
+        /**
+         * @brief directory by index inside cache, -1 if directory is not
+         * listed in theme description
+         */
+        QVector<int> directories;
+    };
+    /**
+     * @brief icon file candidate
+     */
+    struct Candidate {
+        /**
+         * @brief theme rank
+         */
+        int rank;
+        /**
+         * @brief directory index
+         */
+        int directory;
+        /**
+         * @brief path to icon file
+         */
+        QString path;
+    };
+    /**
+     * @brief mapped theme indexes
+     */
+    QList<Cache> m_caches;
+    /**
+     * @brief known directories
+     */
+    QVector<Directory> m_directories;
+    /**
+     * @brief opened index files
+     */
+    QList<QFile *> m_files;
+    /**
+     * @brief icon theme paths
+     */
+    QStringList m_searchPaths;
+    /**
+     * @brief icon theme name
+     */
+    QString m_theme;
+    // methods
+    /**
+     * @brief find icon files with the specified name
+     * @remark the name is not shortened here
+     * @param _name icon name
+     * @return candidates from the most preferred theme which contains icon
+     */
+    QList<Candidate> candidates(const QString &_name) const;
+    /**
+     * @brief generate index for theme directory
+     * @param _root path to theme directory
+     * @param _directories relative paths of icon directories
+     * @param _fileName path to index file
+     * @return true if index has been saved
+     */
+    static bool generate(const QString &_root, const QStringList &_directories,
+                         const QString &_fileName);
+    /**
+     * @brief hash of icon name as it is used by GTK
+     * @param _name icon name
+     * @return hash value
+     */
+    static quint32 hash(const QByteArray &_name);
+    /**
+     * @brief map theme index
+     * @param _fileName path to index file
+     * @param _rank theme rank
+     * @param _directories directory indexes by relative path
+     * @return true if index has been mapped
+     */
+    bool map(const QString &_fileName, const int _rank,
+             const QHash<QString, int> &_directories);
+    /**
+     * @brief load theme
+     * @param _theme theme name
+     * @param _rank theme rank
+     * @return themes from which this theme inherits
+     */
+    QStringList loadTheme(const QString &_theme, const int _rank);
+};
+};
+
+
+#endif /* ICONTHEMEINDEX_H */
@@ -0,0 +1,238 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file ItemStorage.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef ITEMSTORAGE_H
+#define ITEMSTORAGE_H
+
+#include <QObject>
+#include <QSqlDatabase>
+
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+class ApplicationItem;
+
+/**
+ * @brief The ItemStorage class provides transactional storage for user items
+ * such as favorites, recent applications and documents
+ * @remark all items are stored in the single SQLite database inside
+ * @ref HOME_PATH, each object works with items of its own category only. Items
+ * are indexed by name, position and modification time. On the first usage
+ * items are imported from the legacy layout (directory of desktop files and
+ * index.conf) if any
+ */
+class ItemStorage : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief ItemStorage class constructor
+     * @param _parent pointer to parent item
+     * @param _category items category
+     * @param _legacyPath path to desktop files which will be imported on the
+     * first usage
+     */
+    explicit ItemStorage(QObject *_parent, const QString &_category,
+                         const QString &_legacyPath);
+
+    /**
+     * @brief ItemStorage class destructor
+     */
+    virtual ~ItemStorage();
+
+    /**
+     * @brief add item or replace existing one with the same name. Item
+     * modification time will be set to the current time
+     * @param _item pointer to application item
+     * @param _position item position, if it is -1 the item will be placed
+     * after the last one
+     * @return true if item has been saved otherwise returns false
+     */
+    bool addItem(const ApplicationItem *_item, const int _position = -1);
+
+    /**
+     * @brief add items or replace existing ones in the single transaction
+     * @param _items list of application items and their modification times
+     * in ms since epoch
+     * @return true if items have been saved otherwise returns false
+     */
+    bool addItems(const QList<QPair<ApplicationItem *, qint64>> &_items);
+
+    /**
+     * @brief items category
+     * @return category name
+     */
+    QString category() const;
+
+    /**
+     * @brief check whether the item exists
+     * @param _name item name
+     * @return true if item has been found otherwise returns false
+     */
+    bool contains(const QString &_name) const;
+
+    /**
+     * @brief path to database file
+     * @return full path to database file
+     */
+    static QString databasePath();
+
+    /**
+     * @brief write items to the legacy layout
+     * @param _path path to which desktop files and index.conf will be written
+     * @return count of exported items or -1 if an error occurs
+     */
+    int exportDesktops(const QString &_path) const;
+
+    /**
+     * @brief read items from the legacy layout
+     * @remark items will be added to the existing ones in the single
+     * transaction
+     * @param _path path to desktop files and index.conf
+     * @return count of imported items or -1 if an error occurs
+     */
+    int importDesktops(const QString &_path);
+
+    /**
+     * @brief is storage ready for usage
+     * @return true if database has been opened otherwise returns false
+     */
+    bool isValid() const;
+
+    /**
+     * @brief read all items
+     * @param _parent pointer to parent item of created objects
+     * @return items sorted by position and then by modification time
+     */
+    QList<ApplicationItem *> items(QObject *_parent) const;
+
+    /**
+     * @brief item names sorted by modification time from the oldest one
+     * @return list of item names
+     */
+    QStringList namesByTime() const;
+
+    /**
+     * @brief remove item
+     * @param _name item name
+     * @return true if item has been removed otherwise returns false
+     */
+    bool removeItem(const QString &_name);
+
+    /**
+     * @brief remove the oldest items
+     * @param _count maximal count of items which should be kept
+     * @return count of removed items or -1 if an error occurs
+     */
+    int rotate(const int _count);
+
+    /**
+     * @brief set positions of items according to order
+     * @param _order list of item names
+     * @return true if order has been saved otherwise returns false
+     */
+    bool setOrder(const QStringList &_order);
+
+    /**
+     * @brief update properties of existing item, position and modification
+     * time will be kept
+     * @param _item pointer to application item
+     * @return true if item has been updated otherwise returns false
+     */
+    bool updateItem(const ApplicationItem *_item);
+
+    /**
+     * @brief set category specific state value
+     * @param _key value key
+     * @param _value value
+     * @return true if value has been saved otherwise returns false
+     */
+    bool setValue(const QString &_key, const QVariant &_value);
+
+    /**
+     * @brief category specific state value
+     * @param _key value key
+     * @param _default default value
+     * @return value or default value if nothing found
+     */
+    QVariant value(const QString &_key,
+                   const QVariant &_default = QVariant()) const;
+
+private:
+    /**
+     * @brief items category
+     */
+    QString m_category;
+    /**
+     * @brief name of database connection
+     */
+    QString m_connection;
+    // methods
+    /**
+     * @brief database connection
+     * @return database object
+     */
+    QSqlDatabase database() const;
+    /**
+     * @brief create database schema if required
+     * @return true if schema is ready otherwise returns false
+     */
+    bool initSchema();
+    /**
+     * @brief check whether items have been imported from the legacy layout
+     * @return true if import has been done otherwise returns false
+     */
+    bool isImported() const;
+    /**
+     * @brief read items from the legacy layout without transaction
+     * @param _path path to desktop files and index.conf
+     * @return count of read items or -1 if an error occurs
+     */
+    int readDesktops(const QString &_path);
+    /**
+     * @brief mark items as imported from the legacy layout
+     * @return true if flag has been saved otherwise returns false
+     */
+    bool setImported();
+    /**
+     * @brief write item without transaction
+     * @param _item pointer to application item
+     * @param _position item position, -1 means to keep current position or
+     * place item after the last one
+     * @param _modified item modification time in ms since epoch
+     * @return true if item has been written otherwise returns false
+     */
+    bool writeItem(const ApplicationItem *_item, const int _position,
+                   const qint64 _modified);
+};
+};
+
+
+#endif /* ITEMSTORAGE_H */
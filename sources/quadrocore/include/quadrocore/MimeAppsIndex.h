@@ -0,0 +1,145 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file MimeAppsIndex.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef MIMEAPPSINDEX_H
+#define MIMEAPPSINDEX_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+class AbstractAppAggregator;
+
+class ApplicationItem;
+
+/**
+ * @brief The MimeAppsIndex class provides MIME type to application
+ * associations
+ * @remark associations are collected from MimeType keys of the catalogue,
+ * mimeinfo.cache files and mimeapps.list files according to freedesktop
+ * MIME applications associations specification. Applications are identified
+ * by desktop file name. Index is rebuilt on request if catalogue generation
+ * or any of the read files has been changed
+ */
+class MimeAppsIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief MimeAppsIndex class constructor
+     * @param _parent pointer to parent item
+     * @param _source pointer to application aggregator which is used as
+     * catalogue
+     */
+    explicit MimeAppsIndex(QObject *_parent, AbstractAppAggregator *_source);
+
+    /**
+     * @brief MimeAppsIndex class destructor
+     */
+    virtual ~MimeAppsIndex();
+
+    /**
+     * @brief find application by desktop file name
+     * @remark applications which are not in the catalogue (e.g. hidden ones)
+     * are read from desktop files
+     * @param _desktopName desktop file name
+     * @return pointer to application or nullptr if nothing found
+     */
+    ApplicationItem *application(const QString &_desktopName);
+
+    /**
+     * @brief applications which are able to open MIME type
+     * @remark applications associated with parent types are appended to the
+     * end of the list
+     * @param _mimeType MIME type name
+     * @return desktop file names, the default application is the first
+     */
+    QStringList applications(const QString &_mimeType);
+
+    /**
+     * @brief default application of MIME type
+     * @param _mimeType MIME type name
+     * @return pointer to application or nullptr if there is no application
+     */
+    ApplicationItem *defaultApplication(const QString &_mimeType);
+
+private:
+    /**
+     * @brief ranked desktop file names by MIME type
+     */
+    QHash<QString, QStringList> m_associations;
+    /**
+     * @brief known applications by desktop file name
+     */
+    QHash<QString, QPointer<ApplicationItem>> m_applications;
+    /**
+     * @brief catalogue generation of the index, -1 if there is no index
+     */
+    qint64 m_generation = -1;
+    /**
+     * @brief modification times of read files
+     */
+    QHash<QString, QDateTime> m_files;
+    /**
+     * @brief pointer to catalogue
+     */
+    AbstractAppAggregator *m_source = nullptr;
+    // methods
+    /**
+     * @brief paths to mimeapps.list files, the most important is the first
+     * @return list of possible paths
+     */
+    static QStringList mimeAppsFiles();
+    /**
+     * @brief paths to mimeinfo.cache files, the most important is the first
+     * @return list of possible paths
+     */
+    static QStringList mimeInfoFiles();
+    /**
+     * @brief read groups of desktop style file
+     * @param _fileName path to file
+     * @return values split by ";" by group and key
+     */
+    static QHash<QString, QHash<QString, QStringList>>
+    readGroups(const QString &_fileName);
+    /**
+     * @brief rebuild index if it is outdated
+     */
+    void update();
+};
+};
+
+
+#endif /* MIMEAPPSINDEX_H */
@@ -0,0 +1,129 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file MimeResolver.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef MIMERESOLVER_H
+#define MIMERESOLVER_H
+
+#include <QCache>
+#include <QMimeDatabase>
+#include <QMutex>
+#include <QObject>
+
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The MimeResolver class provides cached MIME type detection
+ * @remark results are cached by device, inode and modification time of the
+ * file, thus renamed or replaced files will be detected again. Methods are
+ * thread-safe
+ */
+class MimeResolver : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief MimeResolver class constructor
+     * @param _parent pointer to parent object
+     */
+    explicit MimeResolver(QObject *_parent);
+
+    /**
+     * @brief MimeResolver class destructor
+     */
+    virtual ~MimeResolver();
+
+    /**
+     * @brief MIME type database
+     * @return reference to shared database
+     */
+    const QMimeDatabase &database() const;
+
+    /**
+     * @brief get MIME type of file
+     * @remark QMimeDatabase::MatchExtension does not read the file and should
+     * be used for listings, file content is read only if it is requested
+     * explicitly or if extension is unknown and QMimeDatabase::MatchDefault
+     * is used. Directories and other special files get inode/* types in any
+     * mode
+     * @param _file path to file
+     * @param _mode detection mode
+     * @return MIME type
+     */
+    QMimeType mimeType(const QString &_file,
+                       const QMimeDatabase::MatchMode _mode
+                       = QMimeDatabase::MatchDefault);
+
+private:
+    /**
+     * @brief cached detection result
+     */
+    struct Result {
+        /**
+         * @brief MIME type name
+         */
+        QString name;
+        /**
+         * @brief mode which was used for detection
+         */
+        QMimeDatabase::MatchMode mode;
+    };
+    /**
+     * @brief cached results by file key
+     */
+    QCache<QByteArray, Result> m_cache;
+    /**
+     * @brief cache lock
+     */
+    QMutex m_lock;
+    /**
+     * @brief MIME type database
+     */
+    QMimeDatabase m_database;
+    // methods
+    /**
+     * @brief check whether cached result may be used for request
+     * @param _result cached result
+     * @param _mode requested mode
+     * @return true if cached result is suitable
+     */
+    bool isSuitable(const Result &_result,
+                    const QMimeDatabase::MatchMode _mode) const;
+    /**
+     * @brief MIME type of file which is not regular one
+     * @param _mode file mode as it is returned by stat()
+     * @return MIME type name or empty string for regular files
+     */
+    static QString specialType(const unsigned int _mode);
+};
+};
+
+
+#endif /* MIMERESOLVER_H */
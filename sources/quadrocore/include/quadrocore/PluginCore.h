@@ -83,6 +83,13 @@ public:
      */
     static QStringList desktopPaths();
 
+    /**
+     * @brief current generation of known plugins list
+     * @remark generation is increased each time when plugins are reinitialized
+     * @return generation number
+     */
+    uint generation() const;
+
     /**
      * @brief pass parameter to plugin and init it
      * @param _index plugin index
@@ -151,6 +158,10 @@ private:
      * @brief all available plugins with metadata
      */
     QHash<QString, PluginRepresentation *> m_allPlugins;
+    /**
+     * @brief current generation of known plugins list
+     */
+    uint m_generation = 0;
     /**
      * @brief list of plugins
      */
@@ -30,15 +30,23 @@
 
 #include "AbstractAppAggregator.h"
 #include "ApplicationItem.h"
+#include "CatalogueSnapshot.h"
 #include "ConfigManager.h"
 #include "ConfigManagerAdaptor.h"
 #include "DBusOperations.h"
+#include "DBusTypes.h"
 #include "DesktopInterface.h"
 #include "DocumentsCore.h"
 #include "FavoritesCore.h"
+#include "FileIndex.h"
 #include "FileInfoExtension.h"
 #include "FileManagerCore.h"
+#include "FileSystemWalker.h"
+#include "IconThemeIndex.h"
+#include "ItemStorage.h"
 #include "LauncherCore.h"
+#include "MimeAppsIndex.h"
+#include "MimeResolver.h"
 #include "PluginAdaptor.h"
 #include "PluginCore.h"
 #include "PluginInterface.h"
@@ -52,5 +60,6 @@
 #include "StandaloneApplicationItem.h"
 #include "TabPluginAdaptor.h"
 #include "TabPluginInterface.h"
+#include "XbelReader.h"
 
 #endif /* QUADRO_H */
@@ -27,9 +27,11 @@
 #define QUADROADAPTOR_H
 
 #include <QDBusAbstractAdaptor>
+#include <QDBusUnixFileDescriptor>
 #include <QDBusVariant>
 
 #include "Config.h"
+#include "DBusTypes.h"
 
 
 /**
@@ -59,17 +61,54 @@ public:
     virtual ~QuadroAdaptor();
 
 public slots:
+    /**
+     * @brief launcher applications list
+     * @remark reply is cached and rebuilt only when launcher generation has
+     * been changed
+     * @return metadata of known applications sorted by name
+     */
+    QList<ApplicationMetadata> Applications() const;
+    /**
+     * @brief application catalogue snapshot
+     * @remark the snapshot is sealed memory file which may be mapped
+     * read-only, see CatalogueSnapshot for format description. New snapshot
+     * is published for each ApplicationsChanged() generation
+     * @return file descriptor of the snapshot
+     */
+    QDBusUnixFileDescriptor Catalogue() const;
+    /**
+     * @brief export documents, favorites and recent items to legacy layout
+     * @remark items will be written to documents, favorites and recent
+     * subdirectories as desktop files
+     * @param path path to which items will be exported
+     * @return true if all items have been exported otherwise returns false
+     */
+    bool ExportItems(const QString &path) const;
     /**
      * @brief favorites applications list
      * @return list of application from FavoritesCore
      */
     QStringList Favorites() const;
+    /**
+     * @brief current generations of application lists
+     * @remark generation is the same as the last value sent by change signals
+     * @return hash of generations with keys applications, documents,
+     * favorites and recent
+     */
+    QVariantHash Generations() const;
     /**
      * @brief get icon by file path
      * @param file absolute file path
      * @return icon name of the specified file
      */
     QString Icon(const QString &file) const;
+    /**
+     * @brief get icons by file paths
+     * @remark icons are detected by file names only, file content is not read
+     * @param files absolute file paths
+     * @return icon names of the specified files in the same order
+     */
+    QStringList Icons(const QStringList &files) const;
     /**
      * @brief check if there is a known plugin for this platform
      * @return true if DesktopInterface has been initialized
@@ -81,12 +120,28 @@ public slots:
      * @return mime name of the specified file
      */
     QString MIME(const QString &file) const;
+    /**
+     * @brief get mime names by file paths
+     * @remark types are detected by file names only, file content is not read
+     * @param files absolute file paths
+     * @return mime names of the specified files in the same order
+     */
+    QStringList MIMEs(const QStringList &files) const;
+    /**
+     * @brief move favorites application to the specified position
+     * @remark FavoritesChanged() will be emitted if order has been changed
+     * @param name application name
+     * @param index new application index
+     */
+    Q_NOREPLY void MoveFavorite(const QString &name, const int index) const;
     /**
      * @brief get plugin list
+     * @remark reply is cached and rebuilt only when plugin list generation
+     * has been changed
      * @param group plugin group
-     * @return list of known plugins
+     * @return metadata of known plugins
      */
-    QDBusVariant Plugins(const QString &group) const;
+    QList<PluginMetadata> Plugins(const QString &group) const;
     /**
      * @brief recent applications list
      * @return list of application from RecentlyCore
@@ -94,23 +149,29 @@ public slots:
     QStringList Recent() const;
     /**
      * @brief recent documents list
+     * @remark missing icons are resolved in background, DocumentChanged()
+     * will be emitted for each resolved document
      * @return list of documents from DocumentsCore
      */
     QStringList RecentDocuments() const;
     /**
      * @brief update application list
+     * @remark ApplicationsChanged() will be emitted only if there are changes
      */
     Q_NOREPLY void UpdateApplications() const;
     /**
      * @brief update recently opened documents
+     * @remark DocumentsChanged() will be emitted only if there are changes
      */
     Q_NOREPLY void UpdateDocuments() const;
     /**
      * @brief update favorites applications list
+     * @remark FavoritesChanged() will be emitted only if there are changes
      */
     Q_NOREPLY void UpdateFavorites() const;
     /**
      * @brief update recently run applications
+     * @remark RecentChanged() will be emitted only if there are changes
      */
     Q_NOREPLY void UpdateRecent() const;
     /**
@@ -122,6 +183,54 @@ public slots:
     QStringList WIdForPID(const long long pid);
 
 signals:
+    /**
+     * @brief emitted when application list has been changed
+     * @param generation new generation number
+     * @param added names of added applications
+     * @param removed names of removed applications
+     * @param order new application order if it has been changed, otherwise
+     * empty
+     */
+    void ApplicationsChanged(const uint generation, const QStringList &added,
+                             const QStringList &removed,
+                             const QStringList &order);
+    /**
+     * @brief emitted when properties of recently opened document have been
+     * changed, e.g. its icon has been resolved in background
+     * @param name document name
+     */
+    void DocumentChanged(const QString &name);
+    /**
+     * @brief emitted when recently opened documents have been changed
+     * @param generation new generation number
+     * @param added names of added documents
+     * @param removed names of removed documents
+     * @param order new documents order if it has been changed, otherwise empty
+     */
+    void DocumentsChanged(const uint generation, const QStringList &added,
+                          const QStringList &removed,
+                          const QStringList &order);
+    /**
+     * @brief emitted when favorites applications have been changed
+     * @param generation new generation number
+     * @param added names of added applications
+     * @param removed names of removed applications
+     * @param order new application order if it has been changed, otherwise
+     * empty
+     */
+    void FavoritesChanged(const uint generation, const QStringList &added,
+                          const QStringList &removed,
+                          const QStringList &order);
+    /**
+     * @brief emitted when recently run applications have been changed
+     * @param generation new generation number
+     * @param added names of added applications
+     * @param removed names of removed applications
+     * @param order new application order if it has been changed, otherwise
+     * empty
+     */
+    void RecentChanged(const uint generation, const QStringList &added,
+                       const QStringList &removed, const QStringList &order);
 
 private:
     // properties
@@ -129,6 +238,24 @@ private:
      * @brief pointer to the core
      */
     QuadroCore *m_core = nullptr;
+    /**
+     * @brief cached applications reply
+     */
+    mutable QList<ApplicationMetadata> m_applications;
+    /**
+     * @brief launcher generation of cached applications reply, -1 if there
+     * is no cached reply
+     */
+    mutable qint64 m_applicationsGeneration = -1;
+    /**
+     * @brief cached plugins replies by plugin group
+     */
+    mutable QHash<QString, QList<PluginMetadata>> m_plugins;
+    /**
+     * @brief plugin list generation of cached plugins replies, -1 if there
+     * is no cached reply
+     */
+    mutable qint64 m_pluginsGeneration = -1;
 };
 };
 
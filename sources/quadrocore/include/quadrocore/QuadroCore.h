@@ -35,6 +35,8 @@
  */
 namespace Quadro
 {
+class CatalogueSnapshot;
+
 class ConfigManager;
 
 class DesktopInterface;
@@ -47,6 +49,8 @@ class FileManagerCore;
 
 class LauncherCore;
 
+class MimeAppsIndex;
+
 class PluginCore;
 
 class RecentlyCore;
@@ -70,6 +74,18 @@ public:
      */
     virtual ~QuadroCore();
 
+    /**
+     * @brief application catalogue snapshot object
+     * @return pointer to application catalogue snapshot object
+     */
+    CatalogueSnapshot *catalogue();
+
+    /**
+     * @brief MIME type associations object
+     * @return pointer to MIME type associations object
+     */
+    MimeAppsIndex *associations();
+
     /**
      * @brief configuration manager object
      * @return pointer to configuration manager object
@@ -129,6 +145,14 @@ private:
      */
     void initPlatformPlugin();
 
+    /**
+     * @brief MIME type associations object
+     */
+    MimeAppsIndex *m_associations = nullptr;
+    /**
+     * @brief application catalogue snapshot object
+     */
+    CatalogueSnapshot *m_catalogue = nullptr;
     /**
      * @fn configuration manager object
      */
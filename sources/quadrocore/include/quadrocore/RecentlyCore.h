@@ -38,6 +38,8 @@
  */
 namespace Quadro
 {
+class ItemStorage;
+
 /**
  * @brief The RecentlyCore class provides backend for recently run items
  */
@@ -70,28 +72,44 @@ public:
 
     /**
      * @brief path to desktop files
+     * @remark desktop files are used as legacy layout which is imported to
+     * the storage on the first run
      * @return full path to desktop files
      */
     static QString desktopPath();
 
     /**
-     * @brief return applications which has desktop files
+     * @brief return applications which are stored in the storage
      * @return map of generated ApplicationItem
      */
     QMap<QString, ApplicationItem *> getApplicationsFromDesktops();
 
+    /**
+     * @brief application names sorted by modification time
+     * @return application names, the most recent is the last
+     */
+    QStringList order() const;
+
     /**
      * @brief get recently run applications
-     * @return application names
+     * @return application names sorted by modification time
      */
     QStringList recent() const;
 
+    /**
+     * @brief items storage
+     * @return pointer to items storage
+     */
+    ItemStorage *storage() const;
+
 public slots:
 
     /**
      * @brief add item to recent run
+     * @remark item will be reparented to the core and replaces the existing
+     * one with the same name
      * @param _item pointer to recent item run
-     * @return pointer to created ApplicationItem
+     * @return pointer to stored ApplicationItem
      */
     ApplicationItem *addItem(ApplicationItem *_item);
 
@@ -128,6 +146,10 @@ private:
      * @brief max recent items count
      */
     int m_recentItems;
+    /**
+     * @brief items storage
+     */
+    ItemStorage *m_storage = nullptr;
 
     /**
      * @brief rotate application data information
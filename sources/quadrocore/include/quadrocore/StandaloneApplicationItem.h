@@ -140,6 +140,17 @@ private:
      * @brief widget which contains app
      */
     QList<QWidget *> m_widgets;
+    // methods
+    /**
+     * @brief create window containers for the application windows
+     * @param _windows list of WIds as QString representation
+     */
+    void createWidgets(const QStringList &_windows);
+
+    /**
+     * @brief request application windows from the library
+     */
+    void requestWindows();
 };
 };
 
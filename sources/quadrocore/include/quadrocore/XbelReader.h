@@ -0,0 +1,155 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file XbelReader.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef XBELREADER_H
+#define XBELREADER_H
+
+#include <QDateTime>
+#include <QObject>
+
+
+class QFile;
+class QFileSystemWatcher;
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+class ItemStorage;
+
+/**
+ * @brief The XbelReader class provides incremental reader of recently used
+ * bookmarks (recently-used.xbel)
+ * @remark file is parsed by chunks using stream reader. After each read the
+ * position after the last bookmark is saved to the storage, thus next read
+ * will parse only appended bookmarks. File is reparsed from the beginning
+ * only if it became shorter than saved position or data right before the
+ * position has been changed, thus bookmarks which were updated in place may be
+ * skipped
+ */
+class XbelReader : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief recently used bookmark
+     */
+    struct Bookmark {
+        /**
+         * @brief bookmark URL
+         */
+        QString href;
+        /**
+         * @brief MIME type name if any
+         */
+        QString mimeType;
+        /**
+         * @brief last modification time
+         */
+        QDateTime modified;
+    };
+
+    /**
+     * @brief XbelReader class constructor
+     * @param _parent pointer to parent item
+     * @param _path full path to bookmarks file
+     * @param _storage pointer to storage which is used to keep read position
+     */
+    explicit XbelReader(QObject *_parent, const QString &_path,
+                        ItemStorage *_storage);
+
+    /**
+     * @brief XbelReader class destructor
+     */
+    virtual ~XbelReader();
+
+    /**
+     * @brief default path to bookmarks file
+     * @return full path to recently-used.xbel in user data directory
+     */
+    static QString defaultPath();
+
+    /**
+     * @brief read bookmarks which have been added since the last read
+     * @return list of new bookmarks
+     */
+    QList<Bookmark> read();
+
+signals:
+    /**
+     * @brief signal which will be emitted when bookmarks file has been
+     * changed
+     */
+    void changed();
+
+private slots:
+    /**
+     * @brief file watcher handler
+     * @param _path changed file path
+     */
+    void fileChanged(const QString &_path);
+
+private:
+    /**
+     * @brief full path to bookmarks file
+     */
+    QString m_path;
+    /**
+     * @brief pointer to storage
+     */
+    ItemStorage *m_storage = nullptr;
+    /**
+     * @brief bookmarks file watcher
+     */
+    QFileSystemWatcher *m_watcher = nullptr;
+    // methods
+    /**
+     * @brief find offset after the last complete bookmark
+     * @param _file opened bookmarks file
+     * @return offset in bytes or 0 if nothing found
+     */
+    qint64 lastBookmarkOffset(QFile &_file) const;
+    /**
+     * @brief read root element start tag
+     * @param _file opened bookmarks file
+     * @return raw start tag or empty array if nothing found
+     */
+    QByteArray rootElement(QFile &_file) const;
+    /**
+     * @brief data before offset which is used to check whether file prefix
+     * has been changed
+     * @param _file opened bookmarks file
+     * @param _offset offset in bytes
+     * @return raw data before offset
+     */
+    QByteArray signature(QFile &_file, const qint64 _offset) const;
+};
+};
+
+
+#endif /* XBELREADER_H */
@@ -25,6 +25,8 @@
 
 #include "quadrocore/Quadro.h"
 
+#include <QSet>
+
 using namespace Quadro;
 
 
@@ -132,6 +134,15 @@ QStringList AbstractAppAggregator::availableCategories()
 }
 
 
+/**
+ * @fn generation
+ */
+uint AbstractAppAggregator::generation() const
+{
+    return m_generation;
+}
+
+
 /**
  * @fn hasApplication
  */
@@ -143,6 +154,15 @@ bool AbstractAppAggregator::hasApplication(const QString &_name) const
 }
 
 
+/**
+ * @fn order
+ */
+QStringList AbstractAppAggregator::order() const
+{
+    return m_applications.keys();
+}
+
+
 /**
  * @fn addApplication
  */
@@ -152,6 +172,26 @@ void AbstractAppAggregator::addApplication(ApplicationItem *_item)
 }
 
 
+/**
+ * @fn difference
+ */
+QStringList AbstractAppAggregator::difference(const QStringList &_left,
+                                              const QStringList &_right)
+{
+    QSet<QString> right;
+    for (auto &name : _right)
+        right.insert(name);
+
+    QStringList output;
+    for (auto &name : _left) {
+        if (!right.contains(name))
+            output.append(name);
+    }
+
+    return output;
+}
+
+
 /**
  * @fn dropApplications
  */
@@ -171,3 +211,25 @@ void AbstractAppAggregator::removeApplication(ApplicationItem *_item)
     for (auto &app : keys)
         m_applications.remove(app);
 }
+
+
+/**
+ * @fn notifyChanges
+ */
+void AbstractAppAggregator::notifyChanges(const QStringList &_previous)
+{
+    QStringList current = order();
+
+    QStringList added = difference(current, _previous);
+    QStringList removed = difference(_previous, current);
+    QStringList order = current == _previous ? QStringList() : current;
+    if (added.isEmpty() && removed.isEmpty() && order.isEmpty()) {
+        qCInfo(LOG_LIB) << "Nothing changed, skip notification";
+        return;
+    }
+
+    m_generation++;
+    qCInfo(LOG_LIB) << "Generation" << m_generation << "added" << added
+                    << "removed" << removed;
+    emit(applicationsChanged(m_generation, added, removed, order));
+}
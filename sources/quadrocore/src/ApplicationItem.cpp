@@ -267,6 +267,7 @@ void ApplicationItem::setIcon(const QString &_icon)
     qCDebug(LOG_LIB) << "Icon name" << _icon;
 
     m_icon = _icon;
+    m_appIcon = QIcon();
 }
 
 
@@ -390,7 +391,10 @@ void ApplicationItem::setVersion(const QString &_version)
  */
 QIcon ApplicationItem::appIcon() const
 {
-    return QIcon::fromTheme(m_icon);
+    if (m_appIcon.isNull())
+        m_appIcon = IconThemeIndex::instance()->icon(m_icon);
+
+    return m_appIcon;
 }
 
 
@@ -522,7 +526,7 @@ ApplicationItem *ApplicationItem::fromDesktop(const QString &_desktopPath,
     }
 
     // workaround for lists
-    props = QStringList({"Categories", "Keywords", "MimeTypes"});
+    props = QStringList({"Categories", "Keywords", "MimeType"});
     for (auto &prop : props) {
         QStringList values;
         /// try localized keys
@@ -547,6 +551,27 @@ ApplicationItem *ApplicationItem::fromDesktop(const QString &_desktopPath,
 }
 
 
+/**
+ * @fn fromHash
+ */
+ApplicationItem *ApplicationItem::fromHash(const QVariantHash &_properties,
+                                           QObject *_parent)
+{
+    qCDebug(LOG_LIB) << "Properties" << _properties;
+
+    ApplicationItem *item = new ApplicationItem(_parent, "");
+    for (auto &key : _properties.keys()) {
+        // desktop name is not a desktop entry property
+        if (key == "DesktopName")
+            item->setDesktopName(_properties[key].toString());
+        else
+            item->setProperty(key.toUtf8().constData(), _properties[key]);
+    }
+
+    return item;
+}
+
+
 /**
  * @fn hasSubstring
  */
@@ -588,6 +613,37 @@ bool ApplicationItem::startsWith(const QString &_substr) const
 }
 
 
+/**
+ * @fn toHash
+ */
+QVariantHash ApplicationItem::toHash() const
+{
+    // generate list of known properties
+    QStringList knownProperties
+        = {"Type",    "Version",  "Name",   "GenericName", "NoDisplay",
+           "Comment", "Icon",     "Hidden", "TryExec",     "Exec",
+           "Path",    "Terminal", "URL"};
+    QStringList knownListProperties = {"Categories", "Keywords", "MimeType"};
+
+    QVariantHash properties;
+    for (auto &prop : knownProperties) {
+        QVariant value = property(prop.toUtf8().constData());
+        if (!value.isNull() && !value.toString().isEmpty())
+            properties[prop] = value.toString();
+    }
+    for (auto &prop : knownListProperties) {
+        QVariant value = property(prop.toUtf8().constData());
+        if (!value.isNull() && !value.toStringList().isEmpty())
+            properties[prop] = value.toStringList();
+    }
+    // keep original desktop file name, it may differ from the item name
+    if (!m_desktopName.isEmpty())
+        properties["DesktopName"] = m_desktopName;
+
+    return properties;
+}
+
+
 /**
  * @fn launch
  */
@@ -625,23 +681,15 @@ QString ApplicationItem::saveDesktop(const QString &_desktopPath) const
     settings.setIniCodec("UTF-8");
     qCInfo(LOG_LIB) << "Configuration file" << settings.fileName();
 
-    // generate list of known properties
-    QStringList knownProperties
-        = {"Type",    "Version",  "Name",   "GenericName", "NoDisplay",
-           "Comment", "Icon",     "Hidden", "TryExec",     "Exec",
-           "Path",    "Terminal", "URL"};
-    QStringList knownListProperties = {"Categories", "Keywords", "MimeType"};
-
+    QVariantHash properties = toHash();
+    // desktop name is already stored as the file name
+    properties.remove("DesktopName");
     settings.beginGroup("Desktop Entry");
-    for (auto &prop : knownProperties) {
-        QVariant value = property(prop.toUtf8().constData());
-        if (!value.isNull() && !value.toString().isEmpty())
-            settings.setValue(prop, value.toString());
-    }
-    for (auto &prop : knownListProperties) {
-        QVariant value = property(prop.toUtf8().constData());
-        if (!value.isNull() && !value.toStringList().isEmpty())
-            settings.setValue(prop, value.toStringList().join(';'));
+    for (auto &prop : properties.keys()) {
+        QVariant value = properties[prop];
+        settings.setValue(prop, value.type() == QVariant::StringList
+                                    ? value.toStringList().join(';')
+                                    : value.toString());
     }
     settings.endGroup();
 
@@ -0,0 +1,193 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file CatalogueSnapshot.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+#include "quadrocore/Quadro.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace Quadro;
+
+
+/**
+ * @class CatalogueSnapshot
+ */
+/**
+ * @fn CatalogueSnapshot
+ */
+CatalogueSnapshot::CatalogueSnapshot(QObject *_parent,
+                                     AbstractAppAggregator *_source)
+    : QObject(_parent)
+    , m_source(_source)
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn ~CatalogueSnapshot
+ */
+CatalogueSnapshot::~CatalogueSnapshot()
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    if (m_fd != -1)
+        close(m_fd);
+}
+
+
+/**
+ * @fn fileDescriptor
+ */
+int CatalogueSnapshot::fileDescriptor()
+{
+    if ((m_fd != -1) && (m_generation == m_source->generation()))
+        return m_fd;
+
+    // clients which have already received old descriptor keep their own copy
+    if (m_fd != -1)
+        close(m_fd);
+    m_generation = m_source->generation();
+    m_fd = publish();
+
+    return m_fd;
+}
+
+
+/**
+ * @fn generation
+ */
+uint CatalogueSnapshot::generation() const
+{
+    return m_generation;
+}
+
+
+/**
+ * @fn serialize
+ */
+QByteArray CatalogueSnapshot::serialize(const QList<ApplicationItem *> &_items,
+                                        const uint _generation)
+{
+    qCDebug(LOG_LIB) << "Serialize" << _items.count() << "items generation"
+                     << _generation;
+
+    auto appendNumber = [](QByteArray &_data, const quint32 _value) {
+        _data.append(reinterpret_cast<const char *>(&_value), sizeof(_value));
+    };
+    // string table starts from empty string
+    QByteArray strings(1, '\0');
+    auto appendString = [&strings](const QString &_value) -> quint32 {
+        if (_value.isEmpty())
+            return 0;
+        quint32 offset = strings.size();
+        strings.append(_value.toUtf8());
+        strings.append('\0');
+        return offset;
+    };
+
+    QByteArray records;
+    for (auto item : _items) {
+        appendNumber(records, appendString(item->name()));
+        appendNumber(records, appendString(item->genericName()));
+        appendNumber(records, appendString(item->comment()));
+        appendNumber(records, appendString(item->icon()));
+        appendNumber(records, appendString(item->exec()));
+        appendNumber(records, appendString(item->desktopName()));
+        appendNumber(records, appendString(item->categories().join(';')));
+        appendNumber(records, appendString(item->keywords().join(';')));
+    }
+
+    // 4 bytes of magic and 6 numbers
+    quint32 headerSize = 4 + 6 * sizeof(quint32);
+    QByteArray data("QCAT", 4);
+    appendNumber(data, VERSION);
+    appendNumber(data, _generation);
+    appendNumber(data, _items.count());
+    appendNumber(data, headerSize);
+    appendNumber(data, headerSize + records.size());
+    appendNumber(data, strings.size());
+    data.append(records);
+    data.append(strings);
+
+    return data;
+}
+
+
+/**
+ * @fn publish
+ */
+int CatalogueSnapshot::publish() const
+{
+#ifdef MFD_ALLOW_SEALING
+    QByteArray data
+        = serialize(m_source->applications().values(), m_generation);
+
+    int fd = memfd_create("quadro-catalogue", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd == -1) {
+        qCWarning(LOG_LIB) << "Could not create memory file" << strerror(errno);
+        return -1;
+    }
+
+    qint64 written = 0;
+    while (written < data.size()) {
+        ssize_t result
+            = write(fd, data.constData() + written, data.size() - written);
+        if (result == -1) {
+            if (errno == EINTR)
+                continue;
+            qCWarning(LOG_LIB) << "Could not write snapshot" << strerror(errno);
+            close(fd);
+            return -1;
+        }
+        written += result;
+    }
+    // the file description is shared with receiver, it should read from start
+    if (lseek(fd, 0, SEEK_SET) == -1) {
+        qCWarning(LOG_LIB) << "Could not rewind snapshot" << strerror(errno);
+        close(fd);
+        return -1;
+    }
+
+    // make snapshot read-only for everybody
+    if (fcntl(fd, F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL)
+        == -1) {
+        qCWarning(LOG_LIB) << "Could not seal snapshot" << strerror(errno);
+        close(fd);
+        return -1;
+    }
+
+    qCInfo(LOG_LIB) << "Published snapshot generation" << m_generation
+                    << "size" << data.size();
+    return fd;
+#else
+    qCWarning(LOG_LIB) << "Memory files are not supported on this platform";
+    return -1;
+#endif /* MFD_ALLOW_SEALING */
+}
@@ -96,6 +96,9 @@ QStringList ConfigManager::verifySettings(const QVariantHash &_other, bool *_ok)
         && _other["RecentItemCount"].toInt() < 0) {
         error.append("RecentItemCount");
     }
+    if ((_other.contains("SearchDepth")) && _other["SearchDepth"].toInt() < -1) {
+        error.append("SearchDepth");
+    }
 
     if (_ok)
         *_ok = error.isEmpty();
@@ -121,6 +124,15 @@ int ConfigManager::gridSize() const
 }
 
 
+/**
+ * @fn indexRoots
+ */
+QStringList ConfigManager::indexRoots() const
+{
+    return m_configuration["IndexRoots"].toStringList();
+}
+
+
 /**
  * @fn recentItemCount
  */
@@ -130,6 +142,24 @@ int ConfigManager::recentItemCount() const
 }
 
 
+/**
+ * @fn searchDepth
+ */
+int ConfigManager::searchDepth() const
+{
+    return m_configuration["SearchDepth"].toInt();
+}
+
+
+/**
+ * @fn searchExcludes
+ */
+QStringList ConfigManager::searchExcludes() const
+{
+    return m_configuration["SearchExcludes"].toStringList();
+}
+
+
 /**
  * @fn readSettings
  */
@@ -142,8 +172,12 @@ void ConfigManager::readSettings(const bool _defaults)
 
     settings.beginGroup("Global");
     m_configuration["GridSize"] = settings.value("GridSize", 150);
+    m_configuration["IndexRoots"] = settings.value("IndexRoots", QStringList());
     m_configuration["RecentItemsCount"]
         = settings.value("RecentItemsCount", 20);
+    m_configuration["SearchDepth"] = settings.value("SearchDepth", 32);
+    m_configuration["SearchExcludes"]
+        = settings.value("SearchExcludes", QStringList());
     settings.endGroup();
 
     for (auto &key : m_configuration.keys())
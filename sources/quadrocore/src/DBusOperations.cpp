@@ -20,10 +20,35 @@
 
 #include <QDBusConnection>
 #include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
 
 using namespace Quadro;
 
 
+/**
+ * @fn onReply
+ */
+void DBusOperations::onReply(const QDBusPendingCall &_call, QObject *_receiver,
+                             ReplyHandler _handler)
+{
+    // watcher is owned by receiver, thus it will be destroyed together with
+    // the receiver and the handler will never be called
+    QDBusPendingCallWatcher *watcher
+        = new QDBusPendingCallWatcher(_call, _receiver);
+    QObject::connect(watcher, &QDBusPendingCallWatcher::finished,
+                     [_handler](QDBusPendingCallWatcher *_watcher) {
+                         QDBusMessage response = _watcher->reply();
+                         _watcher->deleteLater();
+                         if (response.type() == QDBusMessage::ErrorMessage) {
+                             qCWarning(LOG_DBUS) << "Error message"
+                                                 << response.errorMessage();
+                             return _handler(QVariantList());
+                         }
+                         return _handler(response.arguments());
+                     });
+}
+
+
 /**
  * @fn sendRequest
  */
@@ -31,7 +56,8 @@ QVariantList DBusOperations::sendRequest(const QString &_service,
                                          const QString &_path,
                                          const QString &_interface,
                                          const QString &_cmd,
-                                         const QVariantList &_args)
+                                         const QVariantList &_args,
+                                         const int _timeout)
 {
     qCDebug(LOG_DBUS) << "Service" << _service << "with interface" << _interface
                       << "path" << _path << "with command" << _cmd
@@ -43,7 +69,7 @@ QVariantList DBusOperations::sendRequest(const QString &_service,
     if (!_args.isEmpty())
         request.setArguments(_args);
 
-    QDBusMessage response = bus.call(request, QDBus::BlockWithGui);
+    QDBusMessage response = bus.call(request, QDBus::BlockWithGui, _timeout);
     QVariantList arguments = response.arguments();
     qCInfo(LOG_DBUS) << "Error message" << response.errorMessage();
 
@@ -51,6 +77,30 @@ QVariantList DBusOperations::sendRequest(const QString &_service,
 }
 
 
+/**
+ * @fn sendRequestAsync
+ */
+QDBusPendingCall DBusOperations::sendRequestAsync(const QString &_service,
+                                                  const QString &_path,
+                                                  const QString &_interface,
+                                                  const QString &_cmd,
+                                                  const QVariantList &_args,
+                                                  const int _timeout)
+{
+    qCDebug(LOG_DBUS) << "Service" << _service << "with interface" << _interface
+                      << "path" << _path << "with command" << _cmd
+                      << "arguments" << _args << "timeout" << _timeout;
+
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    QDBusMessage request
+        = QDBusMessage::createMethodCall(_service, _path, _interface, _cmd);
+    if (!_args.isEmpty())
+        request.setArguments(_args);
+
+    return bus.asyncCall(request, _timeout);
+}
+
+
 /**
  * @fn sendRequestToConfig
  */
@@ -64,6 +114,19 @@ QVariantList DBusOperations::sendRequestToConfig(const QString &_cmd,
 }
 
 
+/**
+ * @fn sendRequestToConfigAsync
+ */
+QDBusPendingCall DBusOperations::sendRequestToConfigAsync(
+    const QString &_cmd, const QVariantList &_args, const int _timeout)
+{
+    qCDebug(LOG_DBUS) << "Command" << _cmd << "with args" << _args;
+
+    return sendRequestAsync(QString(DBUS_SERVICE), QString(DBUS_CONFIG_PATH),
+                            QString(DBUS_INTERFACE), _cmd, _args, _timeout);
+}
+
+
 /**
  * @fn sendRequestToLibrary
  */
@@ -77,6 +140,19 @@ QVariantList DBusOperations::sendRequestToLibrary(const QString &_cmd,
 }
 
 
+/**
+ * @fn sendRequestToLibraryAsync
+ */
+QDBusPendingCall DBusOperations::sendRequestToLibraryAsync(
+    const QString &_cmd, const QVariantList &_args, const int _timeout)
+{
+    qCDebug(LOG_DBUS) << "Command" << _cmd << "with args" << _args;
+
+    return sendRequestAsync(QString(DBUS_SERVICE), QString(DBUS_OBJECT_PATH),
+                            QString(DBUS_INTERFACE), _cmd, _args, _timeout);
+}
+
+
 /**
  * @fn sendRequestToPlugin
  */
@@ -92,6 +168,23 @@ QVariantList DBusOperations::sendRequestToPlugin(const int _index,
 }
 
 
+/**
+ * @fn sendRequestToPluginAsync
+ */
+QDBusPendingCall DBusOperations::sendRequestToPluginAsync(
+    const int _index, const QString &_cmd, const QVariantList &_args,
+    const int _timeout)
+{
+    qCDebug(LOG_DBUS) << "Plugin name with index" << _index << "Command" << _cmd
+                      << "with args" << _args;
+
+    return sendRequestAsync(QString(DBUS_PLUGIN_SERVICE),
+                            QString("/%1").arg(_index),
+                            QString(DBUS_PLUGIN_INTERFACE), _cmd, _args,
+                            _timeout);
+}
+
+
 /**
  * @fn sendRequestToUi
  */
@@ -103,3 +196,17 @@ QVariantList DBusOperations::sendRequestToUi(const QString &_cmd,
     return sendRequest(QString(DBUS_SERVICE), QString(DBUS_UI_OBJECT_PATH),
                        QString(DBUS_INTERFACE), _cmd, _args);
 }
+
+
+/**
+ * @fn sendRequestToUiAsync
+ */
+QDBusPendingCall DBusOperations::sendRequestToUiAsync(const QString &_cmd,
+                                                      const QVariantList &_args,
+                                                      const int _timeout)
+{
+    qCDebug(LOG_DBUS) << "Command" << _cmd << "with args" << _args;
+
+    return sendRequestAsync(QString(DBUS_SERVICE), QString(DBUS_UI_OBJECT_PATH),
+                            QString(DBUS_INTERFACE), _cmd, _args, _timeout);
+}
@@ -0,0 +1,107 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file DBusTypes.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadrocore/Quadro.h"
+
+#include <QDBusMetaType>
+
+using namespace Quadro;
+
+
+/**
+ * @fn operator<<
+ */
+QDBusArgument &Quadro::operator<<(QDBusArgument &_argument,
+                                  const ApplicationMetadata &_metadata)
+{
+    _argument.beginStructure();
+    _argument << _metadata.name << _metadata.genericName << _metadata.comment
+              << _metadata.icon << _metadata.exec << _metadata.desktopName
+              << _metadata.categories << _metadata.keywords;
+    _argument.endStructure();
+
+    return _argument;
+}
+
+
+/**
+ * @fn operator>>
+ */
+const QDBusArgument &Quadro::operator>>(const QDBusArgument &_argument,
+                                        ApplicationMetadata &_metadata)
+{
+    _argument.beginStructure();
+    _argument >> _metadata.name >> _metadata.genericName >> _metadata.comment
+        >> _metadata.icon >> _metadata.exec >> _metadata.desktopName
+        >> _metadata.categories >> _metadata.keywords;
+    _argument.endStructure();
+
+    return _argument;
+}
+
+
+/**
+ * @fn operator<<
+ */
+QDBusArgument &Quadro::operator<<(QDBusArgument &_argument,
+                                  const PluginMetadata &_metadata)
+{
+    _argument.beginStructure();
+    _argument << _metadata.author << _metadata.comment << _metadata.group
+              << _metadata.location << _metadata.name << _metadata.url
+              << _metadata.version;
+    _argument.endStructure();
+
+    return _argument;
+}
+
+
+/**
+ * @fn operator>>
+ */
+const QDBusArgument &Quadro::operator>>(const QDBusArgument &_argument,
+                                        PluginMetadata &_metadata)
+{
+    _argument.beginStructure();
+    _argument >> _metadata.author >> _metadata.comment >> _metadata.group
+        >> _metadata.location >> _metadata.name >> _metadata.url
+        >> _metadata.version;
+    _argument.endStructure();
+
+    return _argument;
+}
+
+
+/**
+ * @fn registerTypes
+ */
+void DBusTypes::registerTypes()
+{
+    qDBusRegisterMetaType<ApplicationMetadata>();
+    qDBusRegisterMetaType<QList<ApplicationMetadata>>();
+    qDBusRegisterMetaType<PluginMetadata>();
+    qDBusRegisterMetaType<QList<PluginMetadata>>();
+}
@@ -26,7 +26,13 @@
 #include "quadrocore/Quadro.h"
 
 #include <QDir>
+#include <QMimeDatabase>
 #include <QStandardPaths>
+#include <QThreadPool>
+#include <QUrl>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
 
 using namespace Quadro;
 
@@ -42,6 +48,15 @@ DocumentsCore::DocumentsCore(QObject *_parent, const int _recentItems)
     , m_recentItems(_recentItems)
 {
     qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    m_storage = new ItemStorage(this, DOCUMENTS_PATH, desktopPath());
+    // icon resolution is not urgent, single thread is enough
+    m_pool = new QThreadPool(this);
+    m_pool->setMaxThreadCount(1);
+
+    m_bookmarks = new XbelReader(this, XbelReader::defaultPath(), m_storage);
+    connect(m_bookmarks, SIGNAL(changed()), this, SLOT(importBookmarks()));
+    importBookmarks();
 }
 
 
@@ -51,6 +66,9 @@ DocumentsCore::DocumentsCore(QObject *_parent, const int _recentItems)
 DocumentsCore::~DocumentsCore()
 {
     qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    m_pool->clear();
+    m_pool->waitForDone();
 }
 
 
@@ -73,33 +91,47 @@ QString DocumentsCore::desktopPath()
  */
 QMap<QString, ApplicationItem *> DocumentsCore::getApplicationsFromDesktops()
 {
-    QStringList filter("*.desktop");
     QMap<QString, ApplicationItem *> items;
-
-    QStringList entries
-        = QDir(desktopPath()).entryList(filter, QDir::Files, QDir::Time);
-    for (auto &entry : entries) {
-        QString desktop = QFileInfo(QDir(desktopPath()), entry).filePath();
-        qCInfo(LOG_LIB) << "Desktop" << desktop;
-        ApplicationItem *item = ApplicationItem::fromDesktop(desktop, this);
+    for (auto item : m_storage->items(this))
         items[item->name()] = item;
-        m_modifications.append(item->name());
-    }
 
     return items;
 }
 
 
+/**
+ * @fn order
+ */
+QStringList DocumentsCore::order() const
+{
+    return m_modifications;
+}
+
+
 /**
  * @fn recent
  */
 QStringList DocumentsCore::recent() const
 {
-    QStringList apps;
-    for (auto item : applications())
-        apps.append(item->name());
+    return order();
+}
+
 
-    return apps;
+/**
+ * @fn storage
+ */
+ItemStorage *DocumentsCore::storage() const
+{
+    return m_storage;
+}
+
+
+/**
+ * @fn setMimeResolver
+ */
+void DocumentsCore::setMimeResolver(MimeResolver *_mime)
+{
+    m_mime = _mime;
 }
 
 
@@ -110,30 +142,89 @@ ApplicationItem *DocumentsCore::addItem(const QString &_name)
 {
     qCDebug(LOG_LIB) << "Item name" << _name;
 
-    rotate();
     QDateTime modification = QDateTime::currentDateTime();
+    QString name = QFileInfo(_name).fileName();
+    QString url
+        = QString("file://%1").arg(QFileInfo(_name).absoluteFilePath());
 
+    QStringList previous = order();
+    bool isNew = !hasApplication(name);
     ApplicationItem *item
-        = new ApplicationItem(this, QFileInfo(_name).fileName());
+        = isNew ? new ApplicationItem(this, name) : applications()[name];
     item->setComment(modification.toString(Qt::ISODate));
     item->setType("Link");
-    item->setUrl(QString("file://%1").arg(QFileInfo(_name).absoluteFilePath()));
-    // get icon
-    QVariantList res = DBusOperations::sendRequestToLibrary(
-        "Icon", QVariantList() << QFileInfo(_name).absoluteFilePath());
-    if (res.isEmpty())
-        item->setIcon("system-run");
-    else
-        item->setIcon(res.at(0).toString());
-
-    if (item->saveDesktop(desktopPath()).isEmpty()) {
-        qCCritical(LOG_LIB) << "Could not save" << item->desktopName();
+    if (item->url() != url) {
+        // icon will be resolved later
+        item->setUrl(url);
+        item->setIcon("");
+    }
+
+    if (!m_storage->addItem(item)) {
+        qCCritical(LOG_LIB) << "Could not save" << item->name();
+        if (isNew)
+            item->deleteLater();
         return nullptr;
     }
-    initApplications();
 
-    item->deleteLater();
-    return applications()[QFileInfo(_name).fileName()];
+    // update in-memory data without rescan
+    if (isNew)
+        addApplication(item);
+    m_modifications.removeAll(name);
+    m_modifications.append(name);
+    rotate();
+    notifyChanges(previous);
+
+    return item;
+}
+
+
+/**
+ * @fn importBookmarks
+ */
+void DocumentsCore::importBookmarks()
+{
+    QList<XbelReader::Bookmark> bookmarks = m_bookmarks->read();
+    // only the newest items will be kept after rotation anyway
+    std::sort(bookmarks.begin(), bookmarks.end(),
+              [](const XbelReader::Bookmark &_left,
+                 const XbelReader::Bookmark &_right) {
+                  return _left.modified > _right.modified;
+              });
+
+    QMimeDatabase database;
+    QList<QPair<ApplicationItem *, qint64>> items;
+    for (auto &bookmark : bookmarks) {
+        if (items.count() == m_recentItems)
+            break;
+        QUrl url(bookmark.href);
+        if (!url.isLocalFile())
+            continue;
+        QString fileName = url.toLocalFile();
+
+        ApplicationItem *item
+            = new ApplicationItem(nullptr, QFileInfo(fileName).fileName());
+        item->setComment(bookmark.modified.toString(Qt::ISODate));
+        item->setType("Link");
+        item->setUrl(QString("file://%1").arg(fileName));
+        // type is already known, do not touch the file itself
+        QMimeType mime = database.mimeTypeForName(bookmark.mimeType);
+        item->setIcon(mime.isValid() ? mime.iconName() : "system-run");
+        items.append(qMakePair(item, bookmark.modified.toMSecsSinceEpoch()));
+    }
+    if (items.isEmpty()) {
+        qCInfo(LOG_LIB) << "No new bookmarks found";
+        return;
+    }
+
+    bool status = m_storage->addItems(items);
+    for (auto &item : items)
+        delete item.first;
+    if (!status) {
+        qCWarning(LOG_LIB) << "Could not import bookmarks";
+        return;
+    }
+    rotate();
+    initApplications();
 }
 
 
@@ -142,6 +233,8 @@ ApplicationItem *DocumentsCore::addItem(const QString &_name)
  */
 void DocumentsCore::initApplications()
 {
+    QStringList previous = order();
+
     // start cleanup
     dropApplications();
     m_modifications.clear();
@@ -149,9 +242,12 @@ void DocumentsCore::initApplications()
     QMap<QString, ApplicationItem *> desktops = getApplicationsFromDesktops();
     for (auto desktop : desktops.values())
         addApplication(desktop);
+    m_modifications = m_storage->namesByTime();
 
     // cleanup
     desktops.clear();
+
+    notifyChanges(previous);
 }
 
 
@@ -167,11 +263,8 @@ void DocumentsCore::removeItemByName(const QString &_name)
         return;
     }
 
-    QFile desktop(QString("%1/%2")
-                      .arg(desktopPath())
-                      .arg(applications()[_name]->desktopName()));
-    if (!desktop.remove()) {
-        qCCritical(LOG_LIB) << "Could not remove" << desktop.fileName();
+    if (!m_storage->removeItem(_name)) {
+        qCCritical(LOG_LIB) << "Could not remove" << _name;
         return;
     }
 
@@ -179,6 +272,44 @@ void DocumentsCore::removeItemByName(const QString &_name)
 }
 
 
+/**
+ * @fn resolveIcons
+ */
+void DocumentsCore::resolveIcons(const QStringList &_names)
+{
+    qCDebug(LOG_LIB) << "Resolve icons for" << _names;
+
+    if (!m_mime) {
+        qCWarning(LOG_LIB) << "No MIME type resolver set";
+        return;
+    }
+
+    MimeResolver *mime = m_mime;
+    for (auto &name : _names) {
+        if ((!hasApplication(name)) || (m_pending.contains(name)))
+            continue;
+        ApplicationItem *item = applications()[name];
+        if (!item->icon().isEmpty())
+            continue;
+
+        m_pending.insert(name);
+        QString fileName = QUrl(item->url()).toLocalFile();
+        QtConcurrent::run(m_pool, [this, mime, name, fileName]() {
+            // file content is read only if extension is unknown
+            QMimeType type
+                = mime->mimeType(fileName, QMimeDatabase::MatchExtension);
+            if (type.isDefault())
+                type = mime->mimeType(fileName, QMimeDatabase::MatchDefault);
+            QString icon = type.iconName();
+            QMetaObject::invokeMethod(this, "setItemIcon",
+                                      Qt::QueuedConnection,
+                                      Q_ARG(QString, name),
+                                      Q_ARG(QString, icon));
+        });
+    }
+}
+
+
 /**
  * @fn touchItem
  */
@@ -191,13 +322,36 @@ void DocumentsCore::touchItem(const QString &_name)
         return;
     }
 
+    QStringList previous = order();
     QDateTime modification = QDateTime::currentDateTime();
     applications()[_name]->setComment(modification.toString(Qt::ISODate));
 
-    applications()[_name]->saveDesktop(desktopPath());
+    m_storage->addItem(applications()[_name]);
     // update order
     int index = m_modifications.indexOf(_name);
     m_modifications.move(index, m_modifications.count() - 1);
+    notifyChanges(previous);
+}
+
+
+/**
+ * @fn setItemIcon
+ */
+void DocumentsCore::setItemIcon(const QString &_name, const QString &_icon)
+{
+    qCDebug(LOG_LIB) << "Icon for" << _name << "is" << _icon;
+
+    m_pending.remove(_name);
+    if (!hasApplication(_name)) {
+        qCInfo(LOG_LIB) << "Item" << _name << "has been removed already";
+        return;
+    }
+
+    ApplicationItem *item = applications()[_name];
+    item->setIcon(_icon.isEmpty() ? "system-run" : _icon);
+    m_storage->updateItem(item);
+
+    emit(itemChanged(_name));
 }
 
 
@@ -206,10 +360,20 @@ void DocumentsCore::touchItem(const QString &_name)
  */
 void DocumentsCore::rotate()
 {
-    if (applications().count() <= m_recentItems) {
+    int removed = m_storage->rotate(m_recentItems);
+    if (removed <= 0) {
         qCInfo(LOG_LIB) << "Nothing to do here";
         return;
     }
 
-    return removeItemByName(m_modifications.first());
+    qCInfo(LOG_LIB) << "Removed" << removed << "outdated items";
+    // keep in-memory data in sync with the storage
+    while (m_modifications.count() > m_recentItems) {
+        QString name = m_modifications.takeFirst();
+        if (!hasApplication(name))
+            continue;
+        ApplicationItem *item = applications()[name];
+        removeApplication(item);
+        item->deleteLater();
+    }
 }
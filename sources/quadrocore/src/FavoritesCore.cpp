@@ -26,12 +26,16 @@
 #include "quadrocore/Quadro.h"
 
 #include <QDir>
-#include <QSettings>
+#include <QSet>
 #include <QStandardPaths>
 
+#include <algorithm>
+
 using namespace Quadro;
 
 
+static FavoritesCore *sharedInstance = nullptr;
+
 /**
  * @class FavoritesCore
  */
@@ -42,6 +46,14 @@ FavoritesCore::FavoritesCore(QObject *_parent)
     : QObject(_parent)
 {
     qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    m_storage = new ItemStorage(this, FAVORITES_PATH, desktopPath());
+
+    // save order once reorder has been finished
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(FAVORITES_SAVE_DELAY);
+    connect(&m_saveTimer, SIGNAL(timeout()), this,
+            SLOT(saveApplicationsOrder()));
 }
 
 
@@ -52,7 +64,13 @@ FavoritesCore::~FavoritesCore()
 {
     qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
 
+    if (sharedInstance == this)
+        sharedInstance = nullptr;
+    // flush pending order changes
+    if (m_saveTimer.isActive())
+        saveApplicationsOrder();
     m_applications.clear();
+    m_names.clear();
 }
 
 
@@ -82,6 +100,12 @@ QMap<QString, ApplicationItem *> FavoritesCore::applications() const
  */
 ApplicationItem *FavoritesCore::addToFavorites(ApplicationItem *_item)
 {
+    if (sharedInstance) {
+        sharedInstance->add(_item);
+        return _item;
+    }
+
+    qCInfo(LOG_LIB) << "No shared instance found, create temporary one";
     FavoritesCore *instance = new FavoritesCore(nullptr);
     instance->initApplications();
 
@@ -113,9 +137,9 @@ ApplicationItem *FavoritesCore::addToFavorites(const QString &_executable,
 /**
  * @fn check
  */
-bool FavoritesCore::check(ApplicationItem *_item)
+bool FavoritesCore::check(ApplicationItem *_item) const
 {
-    return m_applications.contains(_item->name());
+    return m_names.contains(_item->name());
 }
 
 
@@ -134,22 +158,11 @@ QString FavoritesCore::desktopPath()
 
 
 /**
- * @fn getApplicationsFromDesktops
+ * @fn generation
  */
-QMap<QString, ApplicationItem *> FavoritesCore::getApplicationsFromDesktops()
+uint FavoritesCore::generation() const
 {
-    QStringList filter("*.desktop");
-    QMap<QString, ApplicationItem *> items;
-
-    QStringList entries = QDir(desktopPath()).entryList(filter, QDir::Files);
-    for (auto &entry : entries) {
-        QString desktop = QFileInfo(QDir(desktopPath()), entry).filePath();
-        qCInfo(LOG_LIB) << "Desktop" << desktop;
-        ApplicationItem *item = ApplicationItem::fromDesktop(desktop, this);
-        items[item->name()] = item;
-    }
-
-    return items;
+    return m_generation;
 }
 
 
@@ -158,10 +171,17 @@ QMap<QString, ApplicationItem *> FavoritesCore::getApplicationsFromDesktops()
  */
 bool FavoritesCore::hasApplication(ApplicationItem *_item)
 {
+    if (sharedInstance)
+        return sharedInstance->check(_item);
+
+    qCInfo(LOG_LIB) << "No shared instance found, create temporary one";
     FavoritesCore *instance = new FavoritesCore(nullptr);
     instance->initApplications();
 
-    return instance->check(_item);
+    bool status = instance->check(_item);
+    delete instance;
+
+    return status;
 }
 
 
@@ -177,6 +197,15 @@ QString FavoritesCore::indexPath()
 }
 
 
+/**
+ * @fn instance
+ */
+FavoritesCore *FavoritesCore::instance()
+{
+    return sharedInstance;
+}
+
+
 /**
  * @fn order
  */
@@ -186,6 +215,24 @@ QStringList FavoritesCore::order() const
 }
 
 
+/**
+ * @fn setInstance
+ */
+void FavoritesCore::setInstance(FavoritesCore *_instance)
+{
+    sharedInstance = _instance;
+}
+
+
+/**
+ * @fn storage
+ */
+ItemStorage *FavoritesCore::storage() const
+{
+    return m_storage;
+}
+
+
 /**
  * @fn changeApplicationState
  */
@@ -199,7 +246,10 @@ void FavoritesCore::changeApplicationState(const QString &_name, const bool _up)
     if ((next == -1) || (next == m_order.count()))
         return;
 
+    QStringList previous = m_order;
     m_order.swap(current, next);
+    notifyChanges(previous);
+    m_saveTimer.start();
 }
 
 
@@ -208,12 +258,44 @@ void FavoritesCore::changeApplicationState(const QString &_name, const bool _up)
  */
 void FavoritesCore::initApplications()
 {
+    QStringList previous = m_order;
+
     // start cleanup
     m_applications.clear();
+    m_names.clear();
     m_order.clear();
 
-    m_applications = getApplicationsFromDesktops();
-    m_order = getApplicationsOrder();
+    for (auto item : m_storage->items(this)) {
+        m_applications[item->name()] = item;
+        m_order.append(item->name());
+    }
+    for (auto &name : m_order)
+        m_names.insert(name);
+
+    notifyChanges(previous);
+}
+
+
+/**
+ * @fn moveApplication
+ */
+void FavoritesCore::moveApplication(const QString &_name, const int _index)
+{
+    qCDebug(LOG_LIB) << "Move" << _name << "to" << _index;
+
+    int current = m_order.indexOf(_name);
+    if (current == -1) {
+        qCWarning(LOG_LIB) << "Unknown application" << _name;
+        return;
+    }
+    int next = std::max(0, std::min(_index, m_order.count() - 1));
+    if (current == next)
+        return;
+
+    QStringList previous = m_order;
+    m_order.move(current, next);
+    notifyChanges(previous);
+    m_saveTimer.start();
 }
 
 
@@ -222,12 +304,10 @@ void FavoritesCore::initApplications()
  */
 void FavoritesCore::saveApplicationsOrder() const
 {
-    QSettings settings(indexPath(), QSettings::IniFormat);
-    settings.setIniCodec("UTF-8");
-
-    settings.setValue("Order", m_order);
+    qCInfo(LOG_LIB) << "Save order" << m_order;
 
-    settings.sync();
+    if (!m_storage->setOrder(m_order))
+        qCWarning(LOG_LIB) << "Could not save order" << m_order;
 }
 
 
@@ -236,27 +316,38 @@ void FavoritesCore::saveApplicationsOrder() const
  */
 void FavoritesCore::addAppToFavorites(ApplicationItem *_item)
 {
-    if (!_item->saveDesktop(desktopPath()).isEmpty()) {
+    if (m_storage->addItem(_item, m_order.count())) {
         // update data
+        QStringList previous = m_order;
         m_applications[_item->name()] = _item;
+        m_names.insert(_item->name());
         m_order.append(_item->name());
-        saveApplicationsOrder();
+        notifyChanges(previous);
     } else {
-        qCWarning(LOG_LIB) << "Could not save item" << _item->name() << "to"
-                           << desktopPath();
+        qCWarning(LOG_LIB) << "Could not save item" << _item->name();
     }
 }
 
 
 /**
- * @fn getApplicationsOrder
+ * @fn notifyChanges
  */
-QStringList FavoritesCore::getApplicationsOrder() const
+void FavoritesCore::notifyChanges(const QStringList &_previous)
 {
-    QSettings settings(indexPath(), QSettings::IniFormat);
-    settings.setIniCodec("UTF-8");
+    QStringList added
+        = AbstractAppAggregator::difference(m_order, _previous);
+    QStringList removed
+        = AbstractAppAggregator::difference(_previous, m_order);
+    QStringList order = m_order == _previous ? QStringList() : m_order;
+    if (added.isEmpty() && removed.isEmpty() && order.isEmpty()) {
+        qCInfo(LOG_LIB) << "Nothing changed, skip notification";
+        return;
+    }
 
-    return settings.value("Order").toStringList();
+    m_generation++;
+    qCInfo(LOG_LIB) << "Generation" << m_generation << "added" << added
+                    << "removed" << removed;
+    emit(applicationsChanged(m_generation, added, removed, order));
 }
 
 
@@ -265,12 +356,13 @@ QStringList FavoritesCore::getApplicationsOrder() const
  */
 void FavoritesCore::removeAppFromFavorites(ApplicationItem *_item)
 {
-    if (_item->removeDesktop(desktopPath())) {
+    if (m_storage->removeItem(_item->name())) {
+        QStringList previous = m_order;
         m_applications.remove(_item->name());
+        m_names.remove(_item->name());
         m_order.removeAll(_item->name());
-        saveApplicationsOrder();
+        notifyChanges(previous);
     } else {
-        qCWarning(LOG_LIB) << "Could not remove item" << _item->name() << "to"
-                           << desktopPath();
+        qCWarning(LOG_LIB) << "Could not remove item" << _item->name();
     }
 }
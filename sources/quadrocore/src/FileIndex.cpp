@@ -0,0 +1,791 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file FileIndex.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadrocore/Quadro.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QRegExp>
+#include <QSaveFile>
+#include <QSocketNotifier>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <dirent.h>
+#include <fcntl.h>
+#include <iterator>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Quadro;
+
+
+/**
+ * @brief index file magic
+ */
+static const quint32 FILE_INDEX_MAGIC = 0x51464958;
+/**
+ * @brief index file format version
+ */
+static const qint32 FILE_INDEX_VERSION = 1;
+/**
+ * @brief events which are watched for each indexed directory
+ */
+static const quint32 FILE_INDEX_EVENTS
+    = IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MOVED_FROM | IN_MOVED_TO
+      | IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+
+
+/**
+ * @class FileIndex
+ */
+/**
+ * @fn FileIndex
+ */
+FileIndex::FileIndex(QObject *_parent)
+    : QObject(_parent)
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    m_pool = new QThreadPool(this);
+    m_pool->setMaxThreadCount(1);
+
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(FILE_INDEX_SAVE_DELAY);
+    connect(&m_saveTimer, SIGNAL(timeout()), this, SLOT(save()));
+}
+
+
+/**
+ * @fn ~FileIndex
+ */
+FileIndex::~FileIndex()
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    m_cancelled.store(1);
+    m_pool->waitForDone();
+    if (m_saveTimer.isActive())
+        save();
+
+    delete m_notifier;
+    clear(m_tree);
+    if (m_pending) {
+        clear(*m_pending);
+        delete m_pending;
+    }
+    for (auto &scanned : m_scanned)
+        delete scanned.tree;
+}
+
+
+/**
+ * @fn covers
+ */
+bool FileIndex::covers(const QString &_directory) const
+{
+    if (!m_ready)
+        return false;
+
+    QString directory = QDir::cleanPath(_directory);
+    for (auto &root : m_roots) {
+        QString prefix = root.endsWith('/') ? root : root + '/';
+        if ((directory == root) || (directory.startsWith(prefix)))
+            return true;
+    }
+
+    return false;
+}
+
+
+/**
+ * @fn indexPath
+ */
+QString FileIndex::indexPath()
+{
+    return QString("%1/%2/%3")
+        .arg(QStandardPaths::writableLocation(
+            QStandardPaths::GenericDataLocation))
+        .arg(HOME_PATH)
+        .arg(FILE_INDEX_FILE);
+}
+
+
+/**
+ * @fn roots
+ */
+QStringList FileIndex::roots() const
+{
+    return m_roots;
+}
+
+
+/**
+ * @fn search
+ */
+QFileInfoList FileIndex::search(const QString &_directory,
+                                const QString &_substr, const bool _hidden,
+                                const QStringList &_excludes,
+                                const int _maxDepth) const
+{
+    qCDebug(LOG_LIB) << "Directory" << _directory << "and show hidden"
+                     << _hidden << "substring" << _substr;
+
+    QString directory = QDir::cleanPath(_directory);
+    QString prefix = directory.endsWith('/') ? directory : directory + '/';
+    QList<QRegExp> excludes;
+    for (auto &pattern : _excludes)
+        excludes.append(QRegExp(pattern, Qt::CaseSensitive, QRegExp::Wildcard));
+
+    // use the same matching as the walker does, candidates are found by the
+    // longest part of the pattern without wildcards
+    QRegExp matcher = FileSystemWalker::nameMatcher(_substr);
+    QString literal = _substr;
+    literal.replace(QRegExp("\\[[^\\]]*\\]"), "*");
+    QStringList literals = literal.split(QRegExp("[*?\\[\\]]"));
+    std::sort(literals.begin(), literals.end(),
+              [](const QString &_left, const QString &_right) {
+                  return _left.length() > _right.length();
+              });
+
+    QFileInfoList found;
+    for (auto index : candidates(m_tree, literals.first().toLower())) {
+        const Entry &entry = m_tree.entries.at(index);
+        if ((entry.removed) || (entry.parent == -1))
+            continue;
+        if (!matcher.exactMatch(entry.name))
+            continue;
+        QString filePath = path(index);
+        if (!filePath.startsWith(prefix))
+            continue;
+
+        // apply the same rules as the walker does
+        QStringList parts = filePath.mid(prefix.length()).split('/');
+        if ((_maxDepth != -1) && (parts.count() > _maxDepth + 1))
+            continue;
+        bool accepted = true;
+        QString current = prefix;
+        for (auto &part : parts) {
+            current += part;
+            accepted = _hidden || !part.startsWith('.');
+            for (auto &exclude : excludes) {
+                if (!accepted)
+                    break;
+                accepted = !exclude.exactMatch(
+                    exclude.pattern().contains('/') ? current : part);
+            }
+            if (!accepted)
+                break;
+            current += '/';
+        }
+        if (accepted)
+            found.append(QFileInfo(filePath));
+    }
+
+    return found;
+}
+
+
+/**
+ * @fn setRoots
+ */
+void FileIndex::setRoots(const QStringList &_roots)
+{
+    qCDebug(LOG_LIB) << "Index roots" << _roots;
+
+    QStringList roots;
+    for (auto &root : _roots)
+        roots.append(QDir::cleanPath(QDir(root).absolutePath()));
+    roots.removeDuplicates();
+    if (roots == m_roots)
+        return;
+
+    // drop current index
+    m_cancelled.store(1);
+    m_pool->waitForDone();
+    m_saveTimer.stop();
+    delete m_notifier;
+    m_notifier = nullptr;
+    clear(m_tree);
+    m_deferred.clear();
+    m_generation++;
+    m_ready = false;
+
+    m_roots = roots;
+    if (m_roots.isEmpty()) {
+        qCInfo(LOG_LIB) << "File index is disabled";
+        return;
+    }
+
+    if (!load())
+        qCInfo(LOG_LIB) << "No saved index found, it will be built";
+    rebuild();
+}
+
+
+/**
+ * @fn rebuild
+ */
+void FileIndex::rebuild()
+{
+    if (m_roots.isEmpty()) {
+        qCWarning(LOG_LIB) << "No roots set";
+        return;
+    }
+
+    m_cancelled.store(1);
+    m_pool->waitForDone();
+    m_cancelled.store(0);
+
+    QStringList roots = m_roots;
+    QtConcurrent::run(m_pool, [this, roots]() {
+        Tree *tree = new Tree();
+        tree->fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (tree->fd == -1)
+            qCWarning(LOG_LIB) << "Could not init inotify, index will not be "
+                                  "updated";
+        for (auto &root : roots)
+            scan(*tree, append(*tree, -1, root, true), root, &m_cancelled);
+
+        if (m_cancelled.load()) {
+            clear(*tree);
+            delete tree;
+            return;
+        }
+        QMutexLocker locker(&m_pendingLock);
+        if (m_pending) {
+            clear(*m_pending);
+            delete m_pending;
+        }
+        m_pending = tree;
+        QMetaObject::invokeMethod(this, "applyBuild", Qt::QueuedConnection);
+    });
+}
+
+
+/**
+ * @fn save
+ */
+bool FileIndex::save() const
+{
+    if (!m_ready) {
+        qCWarning(LOG_LIB) << "Index is not ready yet";
+        return false;
+    }
+
+    QString fileName = indexPath();
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(LOG_LIB) << "Could not open file" << fileName;
+        return false;
+    }
+
+    // removed entries and their children are dropped here
+    QVector<int> mapping(m_tree.entries.count(), -1);
+    qint32 count = 0;
+    for (int i = 0; i < m_tree.entries.count(); i++) {
+        const Entry &entry = m_tree.entries.at(i);
+        if ((entry.removed)
+            || ((entry.parent != -1) && (mapping.at(entry.parent) == -1)))
+            continue;
+        mapping[i] = count++;
+    }
+
+    QDataStream stream(&file);
+    stream << FILE_INDEX_MAGIC << FILE_INDEX_VERSION << m_roots << count;
+    for (int i = 0; i < m_tree.entries.count(); i++) {
+        if (mapping.at(i) == -1)
+            continue;
+        const Entry &entry = m_tree.entries.at(i);
+        qint32 parent = entry.parent == -1 ? -1 : mapping.at(entry.parent);
+        stream << parent << entry.name << entry.directory;
+    }
+
+    qCInfo(LOG_LIB) << "Saved" << count << "entries to" << fileName;
+    return (stream.status() == QDataStream::Ok) && file.commit();
+}
+
+
+/**
+ * @fn applyBuild
+ */
+void FileIndex::applyBuild()
+{
+    Tree *tree = nullptr;
+    {
+        QMutexLocker locker(&m_pendingLock);
+        tree = m_pending;
+        m_pending = nullptr;
+    }
+    if (!tree) {
+        qCInfo(LOG_LIB) << "Nothing to apply";
+        return;
+    }
+
+    delete m_notifier;
+    m_notifier = nullptr;
+    clear(m_tree);
+    // data is implicitly shared, there is no deep copy here
+    m_tree = *tree;
+    delete tree;
+    m_generation++;
+    m_deferred.clear();
+    if (m_tree.fd != -1) {
+        m_notifier
+            = new QSocketNotifier(m_tree.fd, QSocketNotifier::Read, this);
+        connect(m_notifier, SIGNAL(activated(int)), this, SLOT(readEvents()));
+    }
+    m_ready = true;
+
+    qCInfo(LOG_LIB) << "Index has been built with" << m_tree.entries.count()
+                    << "entries";
+    save();
+    emit(ready());
+}
+
+
+/**
+ * @fn applyScan
+ */
+void FileIndex::applyScan()
+{
+    QList<Scan> scanned;
+    {
+        QMutexLocker locker(&m_pendingLock);
+        scanned = m_scanned;
+        m_scanned.clear();
+    }
+
+    bool changed = false;
+    for (auto &result : scanned) {
+        m_scans--;
+        if (!result.tree)
+            continue;
+        // index may be replaced while directory was being scanned
+        if (result.generation == m_generation) {
+            merge(*result.tree, result.index);
+            changed = true;
+        }
+        delete result.tree;
+    }
+
+    // replay events which have been received before watches were merged
+    QList<Event> deferred = m_deferred;
+    m_deferred.clear();
+    for (auto &event : deferred)
+        changed |= processEvent(event);
+
+    if (changed)
+        m_saveTimer.start();
+}
+
+
+/**
+ * @fn readEvents
+ */
+void FileIndex::readEvents()
+{
+    char buffer[4096]
+        __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool changed = false;
+
+    forever {
+        ssize_t length = ::read(m_tree.fd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        const struct inotify_event *event = nullptr;
+        for (char *ptr = buffer; ptr < buffer + length;
+             ptr += sizeof(struct inotify_event) + event->len) {
+            event = reinterpret_cast<const struct inotify_event *>(ptr);
+            if (event->mask & IN_Q_OVERFLOW) {
+                qCWarning(LOG_LIB) << "Events have been lost, rebuild index";
+                rebuild();
+                return;
+            }
+
+            Event current = {event->wd, event->mask,
+                             event->len == 0 ? QString()
+                                             : QFile::decodeName(event->name)};
+            changed |= processEvent(current);
+        }
+    }
+
+    if (changed)
+        m_saveTimer.start();
+}
+
+
+/**
+ * @fn append
+ */
+int FileIndex::append(Tree &_tree, const int _parent, const QString &_name,
+                      const bool _directory)
+{
+    Entry entry = {_parent, _name, _directory, false};
+    _tree.entries.append(entry);
+
+    int index = _tree.entries.count() - 1;
+    // roots are never returned by search
+    if (_parent != -1) {
+        for (auto trigram : trigrams(_name.toLower()))
+            _tree.trigrams[trigram].append(index);
+        _tree.children[_parent][_name] = index;
+    }
+
+    return index;
+}
+
+
+/**
+ * @fn candidates
+ */
+QVector<int> FileIndex::candidates(const Tree &_tree, const QString &_substr)
+{
+    QVector<int> found;
+    if (_substr.length() < 3) {
+        found.reserve(_tree.entries.count());
+        for (int i = 0; i < _tree.entries.count(); i++)
+            found.append(i);
+        return found;
+    }
+
+    // lists are sorted by construction, intersect them from the shortest one
+    QList<QVector<int>> lists;
+    for (auto trigram : trigrams(_substr)) {
+        if (!_tree.trigrams.contains(trigram))
+            return QVector<int>();
+        lists.append(_tree.trigrams[trigram]);
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const QVector<int> &_left, const QVector<int> &_right) {
+                  return _left.count() < _right.count();
+              });
+
+    found = lists.takeFirst();
+    for (auto &list : lists) {
+        QVector<int> intersection;
+        std::set_intersection(found.constBegin(), found.constEnd(),
+                              list.constBegin(), list.constEnd(),
+                              std::back_inserter(intersection));
+        found = intersection;
+    }
+
+    return found;
+}
+
+
+/**
+ * @fn clear
+ */
+void FileIndex::clear(Tree &_tree)
+{
+    if (_tree.fd != -1)
+        ::close(_tree.fd);
+
+    _tree.children.clear();
+    _tree.entries.clear();
+    _tree.fd = -1;
+    _tree.trigrams.clear();
+    _tree.watches.clear();
+}
+
+
+/**
+ * @fn find
+ */
+int FileIndex::find(const int _parent, const QString &_name) const
+{
+    int index = m_tree.children.value(_parent).value(_name, -1);
+    if ((index == -1) || (m_tree.entries.at(index).removed))
+        return -1;
+
+    return index;
+}
+
+
+/**
+ * @fn load
+ */
+bool FileIndex::load()
+{
+    QString fileName = indexPath();
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCInfo(LOG_LIB) << "Could not open file" << fileName;
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic;
+    qint32 version;
+    QStringList roots;
+    qint32 count;
+    stream >> magic >> version >> roots >> count;
+    if ((magic != FILE_INDEX_MAGIC) || (version != FILE_INDEX_VERSION)
+        || (roots != m_roots)) {
+        qCInfo(LOG_LIB) << "Saved index is outdated";
+        return false;
+    }
+
+    Tree tree;
+    tree.entries.reserve(count);
+    for (int i = 0; (i < count) && (stream.status() == QDataStream::Ok);
+         i++) {
+        qint32 parent;
+        QString name;
+        bool directory;
+        stream >> parent >> name >> directory;
+        append(tree, parent, name, directory);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(LOG_LIB) << "Could not read index from" << fileName;
+        return false;
+    }
+
+    m_tree = tree;
+    m_generation++;
+    m_ready = true;
+    qCInfo(LOG_LIB) << "Loaded" << count << "entries from" << fileName;
+
+    return true;
+}
+
+
+/**
+ * @fn merge
+ */
+void FileIndex::merge(const Tree &_tree, const int _index)
+{
+    // parent is always placed before its children, the first entry is the
+    // scanned directory itself
+    QVector<int> mapping(_tree.entries.count(), _index);
+    for (int i = 1; i < _tree.entries.count(); i++) {
+        const Entry &entry = _tree.entries.at(i);
+        mapping[i] = append(m_tree, mapping.at(entry.parent), entry.name,
+                            entry.directory);
+    }
+    for (auto wd : _tree.watches.keys())
+        m_tree.watches[wd] = mapping.at(_tree.watches[wd]);
+}
+
+
+/**
+ * @fn path
+ */
+QString FileIndex::path(const int _index) const
+{
+    QStringList parts;
+    for (int index = _index; index != -1;
+         index = m_tree.entries.at(index).parent) {
+        const Entry &entry = m_tree.entries.at(index);
+        if (entry.removed)
+            return QString();
+        parts.prepend(entry.name);
+    }
+
+    QString filePath = parts.takeFirst();
+    for (auto &part : parts) {
+        if (!filePath.endsWith('/'))
+            filePath += '/';
+        filePath += part;
+    }
+
+    return filePath;
+}
+
+
+/**
+ * @fn processEvent
+ */
+bool FileIndex::processEvent(const Event &_event)
+{
+    if (!m_tree.watches.contains(_event.wd)) {
+        // watch may be added by directory scan which is not merged yet
+        if (m_scans > 0)
+            m_deferred.append(_event);
+        return false;
+    }
+
+    int parent = m_tree.watches[_event.wd];
+    if (_event.mask & IN_IGNORED) {
+        m_tree.watches.remove(_event.wd);
+        return false;
+    }
+    if (_event.mask & IN_DELETE_SELF) {
+        m_tree.entries[parent].removed = true;
+        return true;
+    }
+    if (_event.name.isEmpty())
+        return false;
+
+    int index = find(parent, _event.name);
+    if (_event.mask & (IN_DELETE | IN_MOVED_FROM)) {
+        if (index == -1)
+            return false;
+        // children will be skipped by path lookup
+        m_tree.entries[index].removed = true;
+    } else if (_event.mask & (IN_CREATE | IN_MOVED_TO)) {
+        if (index != -1)
+            return false;
+        bool directory = _event.mask & IN_ISDIR;
+        index = append(m_tree, parent, _event.name, directory);
+        QString directoryPath = path(index);
+        if ((directory) && (!directoryPath.isEmpty()))
+            scanDirectory(index, directoryPath);
+    }
+
+    return true;
+}
+
+
+/**
+ * @fn scan
+ */
+void FileIndex::scan(Tree &_tree, const int _index, const QString &_path,
+                     const QAtomicInt *_cancelled)
+{
+    struct stat root;
+    if (::lstat(QFile::encodeName(_path).constData(), &root) != 0) {
+        qCWarning(LOG_LIB) << "Could not read" << _path;
+        return;
+    }
+    QStringList pruned = FileSystemWalker::prunedPaths();
+
+    QList<QPair<int, QByteArray>> directories
+        = {qMakePair(_index, QFile::encodeName(_path))};
+    while (!directories.isEmpty()) {
+        if ((_cancelled) && (_cancelled->load()))
+            return;
+        QPair<int, QByteArray> current = directories.takeLast();
+        QByteArray prefix = current.second.endsWith('/')
+                                ? current.second
+                                : current.second + '/';
+
+        // watch is added before read, thus no changes will be lost
+        if (_tree.fd != -1) {
+            int wd = ::inotify_add_watch(_tree.fd, current.second.constData(),
+                                         FILE_INDEX_EVENTS);
+            if (wd == -1)
+                qCWarning(LOG_LIB) << "Could not watch" << current.second;
+            else
+                _tree.watches[wd] = current.first;
+        }
+
+        DIR *dir = ::opendir(current.second.constData());
+        if (!dir)
+            continue;
+        int fd = ::dirfd(dir);
+        while (struct dirent *entry = ::readdir(dir)) {
+            QByteArray name = entry->d_name;
+            if ((name == ".") || (name == ".."))
+                continue;
+
+            struct stat info;
+            bool hasInfo = false;
+            bool isDir = entry->d_type == DT_DIR;
+            if (entry->d_type == DT_UNKNOWN) {
+                hasInfo = ::fstatat(fd, entry->d_name, &info,
+                                    AT_SYMLINK_NOFOLLOW)
+                          == 0;
+                isDir = hasInfo && S_ISDIR(info.st_mode);
+            }
+            int index
+                = append(_tree, current.first, QFile::decodeName(name), isDir);
+            if (!isDir)
+                continue;
+
+            // the same rules as the walker uses
+            if (pruned.contains(QFile::decodeName(prefix + name)))
+                continue;
+            if ((!hasInfo)
+                && (::fstatat(fd, entry->d_name, &info, AT_SYMLINK_NOFOLLOW)
+                    != 0))
+                continue;
+            if (info.st_dev != root.st_dev)
+                continue;
+            directories.append(qMakePair(index, prefix + name));
+        }
+        ::closedir(dir);
+    }
+}
+
+
+/**
+ * @fn scanDirectory
+ */
+void FileIndex::scanDirectory(const int _index, const QString &_path)
+{
+    qCDebug(LOG_LIB) << "Queue scan of" << _path;
+
+    // watches are added to the inotify instance of the current index. The
+    // scan uses its own descriptor, thus the instance is kept alive even if
+    // the index has been replaced meanwhile, outdated results are dropped
+    // by generation
+    int fd = m_tree.fd == -1 ? -1 : ::fcntl(m_tree.fd, F_DUPFD_CLOEXEC, 0);
+    int generation = m_generation;
+    m_scans++;
+    QtConcurrent::run(m_pool, [this, _index, _path, fd, generation]() {
+        Tree *tree = new Tree();
+        tree->fd = fd;
+        scan(*tree, append(*tree, -1, _path, true), _path, &m_cancelled);
+        if (fd != -1)
+            ::close(fd);
+        tree->fd = -1;
+        if (m_cancelled.load()) {
+            delete tree;
+            tree = nullptr;
+        }
+
+        Scan result = {generation, _index, tree};
+        QMutexLocker locker(&m_pendingLock);
+        m_scanned.append(result);
+        QMetaObject::invokeMethod(this, "applyScan", Qt::QueuedConnection);
+    });
+}
+
+
+/**
+ * @fn trigrams
+ */
+QList<quint64> FileIndex::trigrams(const QString &_name)
+{
+    QList<quint64> found;
+    for (int i = 0; i + 2 < _name.length(); i++) {
+        quint64 trigram = (static_cast<quint64>(_name.at(i).unicode()) << 32)
+                          | (static_cast<quint64>(_name.at(i + 1).unicode())
+                             << 16)
+                          | _name.at(i + 2).unicode();
+        if (!found.contains(trigram))
+            found.append(trigram);
+    }
+
+    return found;
+}
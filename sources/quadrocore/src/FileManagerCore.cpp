@@ -29,8 +29,10 @@
 #include <QDir>
 #include <QDirIterator>
 #include <QIcon>
-#include <QMimeDatabase>
+#include <QMutex>
+#include <QThreadPool>
 #include <QUrl>
+#include <QtConcurrent/QtConcurrentRun>
 
 using namespace Quadro;
 
@@ -45,6 +47,11 @@ FileManagerCore::FileManagerCore(QObject *_parent)
     : QObject(_parent)
 {
     qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    qRegisterMetaType<QFileInfoList>("QFileInfoList");
+    m_index = new FileIndex(this);
+    m_mime = new MimeResolver(this);
+    m_pool = new QThreadPool(this);
 }
 
 
@@ -54,6 +61,14 @@ FileManagerCore::FileManagerCore(QObject *_parent)
 FileManagerCore::~FileManagerCore()
 {
     qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    // stop active requests before destruction
+    for (auto request : m_requests.values())
+        request->store(1);
+    // walkers wait for own workers on destruction
+    qDeleteAll(m_walkers);
+    m_walkers.clear();
+    m_pool->waitForDone();
 }
 
 
@@ -91,56 +106,217 @@ QFileInfoList FileManagerCore::entriesBySubstr(const QString &_directory,
     qCDebug(LOG_LIB) << "Directory" << _directory << "and show hidden"
                      << _hidden << "substring" << _substr;
 
-    QDir::Filters filters
-        = _hidden ? QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden
-                  : QDir::AllEntries | QDir::NoDotAndDotDot;
-    QFileInfoList foundEntries;
-
-    QDirIterator it(_directory, QStringList({QString("*%1*").arg(_substr)}),
-                    filters, QDirIterator::Subdirectories);
-    while (it.hasNext()) {
-        it.next();
-        foundEntries.append(it.fileInfo());
+    if (!QDir(_directory).exists()) {
+        qCCritical(LOG_LIB) << "Could not find directory" << _directory;
+        return QFileInfoList();
     }
+    if (m_index->covers(_directory))
+        return m_index->search(_directory, _substr, _hidden, m_excludes,
+                               m_searchDepth);
+
+    QFileInfoList foundEntries;
+    QMutex lock;
+    FileSystemWalker walker(nullptr, -1, _directory, _substr, _hidden);
+    walker.setExcludes(m_excludes);
+    walker.setMaxDepth(m_searchDepth);
+    // chunks are emitted from worker threads
+    connect(&walker, &FileSystemWalker::entriesFound,
+            [&foundEntries, &lock](const int, const QFileInfoList &_entries) {
+                QMutexLocker locker(&lock);
+                foundEntries.append(_entries);
+            });
+    walker.start();
+    walker.wait();
 
     return foundEntries;
 }
 
 
+/**
+ * @fn index
+ */
+FileIndex *FileManagerCore::index() const
+{
+    return m_index;
+}
+
+
+/**
+ * @fn mimeResolver
+ */
+MimeResolver *FileManagerCore::mimeResolver() const
+{
+    return m_mime;
+}
+
+
+/**
+ * @fn setAssociations
+ */
+void FileManagerCore::setAssociations(MimeAppsIndex *_associations)
+{
+    m_associations = _associations;
+}
+
+
+/**
+ * @fn setIndexRoots
+ */
+void FileManagerCore::setIndexRoots(const QStringList &_roots)
+{
+    qCDebug(LOG_LIB) << "Index roots" << _roots;
+
+    m_index->setRoots(_roots);
+}
+
+
+/**
+ * @fn setSearchRules
+ */
+void FileManagerCore::setSearchRules(const QStringList &_excludes,
+                                     const int _maxDepth)
+{
+    qCDebug(LOG_LIB) << "Search excludes" << _excludes << "and depth"
+                     << _maxDepth;
+
+    m_excludes = _excludes;
+    m_searchDepth = _maxDepth;
+}
+
+
 /**
  * @fn iconByFileName
  */
-QIcon FileManagerCore::iconByFileName(const QString &_file) const
+QIcon FileManagerCore::iconByFileName(
+    const QString &_file, const QMimeDatabase::MatchMode _mode) const
 {
     qCDebug(LOG_LIB) << "File" << _file;
 
-    return QIcon::fromTheme(iconNameByFileName(_file));
+    return IconThemeIndex::instance()->icon(iconNameByFileName(_file, _mode));
 }
 
 
 /**
  * @fn iconNameByFileName
  */
-QString FileManagerCore::iconNameByFileName(const QString &_file) const
+QString FileManagerCore::iconNameByFileName(
+    const QString &_file, const QMimeDatabase::MatchMode _mode) const
 {
     qCDebug(LOG_LIB) << "File" << _file;
 
-    return mimeByFileName(_file).iconName();
+    return mimeByFileName(_file, _mode).iconName();
+}
+
+
+/**
+ * @fn iconNamesByFileNames
+ */
+QStringList FileManagerCore::iconNamesByFileNames(
+    const QStringList &_files, const QMimeDatabase::MatchMode _mode) const
+{
+    qCDebug(LOG_LIB) << "Files" << _files;
+
+    QStringList icons;
+    for (auto &mime : mimesByFileNames(_files, _mode))
+        icons.append(mime.iconName());
+
+    return icons;
 }
 
 
 /**
  * @fn mimeTypeForFile
  */
-QMimeType FileManagerCore::mimeByFileName(const QString &_file) const
+QMimeType
+FileManagerCore::mimeByFileName(const QString &_file,
+                                const QMimeDatabase::MatchMode _mode) const
 {
     qCDebug(LOG_LIB) << "File" << _file;
 
-    QMimeDatabase database;
-    QMimeType type = database.mimeTypeForFile(_file);
-    qCDebug(LOG_LIB) << "Mime type" << type.name();
+    return m_mime->mimeType(_file, _mode);
+}
+
+
+/**
+ * @fn mimesByFileNames
+ */
+QList<QMimeType>
+FileManagerCore::mimesByFileNames(const QStringList &_files,
+                                  const QMimeDatabase::MatchMode _mode) const
+{
+    qCDebug(LOG_LIB) << "Files" << _files;
+
+    QList<QMimeType> types;
+    for (auto &file : _files)
+        types.append(mimeByFileName(file, _mode));
+
+    return types;
+}
+
+
+/**
+ * @fn cancelRequest
+ */
+void FileManagerCore::cancelRequest(const int _id)
+{
+    qCDebug(LOG_LIB) << "Cancel request" << _id;
+
+    if (m_walkers.contains(_id)) {
+        m_walkers[_id]->cancel();
+        return;
+    }
+    if (!m_requests.contains(_id)) {
+        qCInfo(LOG_LIB) << "Request" << _id << "has been finished already";
+        return;
+    }
+
+    m_requests[_id]->store(1);
+}
+
+
+/**
+ * @fn listDirectory
+ */
+int FileManagerCore::listDirectory(const QString &_directory,
+                                   const bool _hidden,
+                                   const QStringList &_filter)
+{
+    qCDebug(LOG_LIB) << "Directory" << _directory << "and show hidden"
+                     << _hidden << "filter" << _filter;
+
+    if (!QDir(_directory).exists()) {
+        qCCritical(LOG_LIB) << "Could not find directory" << _directory;
+        return -1;
+    }
+
+    int id = ++m_lastRequest;
+    QDir::Filters filters = _hidden
+                                ? QDir::AllEntries | QDir::Hidden | QDir::NoDot
+                                : QDir::AllEntries | QDir::NoDot;
+    QSharedPointer<QAtomicInt> cancelled(new QAtomicInt(0));
+    m_requests[id] = cancelled;
 
-    return type;
+    QtConcurrent::run(m_pool, [this, id, _directory, _filter, filters,
+                               cancelled]() {
+        QFileInfoList chunk;
+        QDirIterator it(_directory, _filter, filters);
+        while (it.hasNext() && !cancelled->load()) {
+            it.next();
+            chunk.append(it.fileInfo());
+            if (chunk.count() < FILEMANAGER_CHUNK_SIZE)
+                continue;
+            emit(entriesReceived(id, chunk));
+            chunk.clear();
+        }
+        if (!chunk.isEmpty() && !cancelled->load())
+            emit(entriesReceived(id, chunk));
+
+        emit(listingFinished(id, cancelled->load() != 0));
+        QMetaObject::invokeMethod(this, "removeRequest", Qt::QueuedConnection,
+                                  Q_ARG(int, id));
+    });
+
+    return id;
 }
 
 
@@ -152,6 +328,81 @@ bool FileManagerCore::openFile(const QFileInfo &_file) const
     qCDebug(LOG_LIB) << "File" << _file.absoluteFilePath();
 
     QUrl url = QUrl::fromLocalFile(_file.absoluteFilePath());
+    if (m_associations) {
+        QString mime = mimeByFileName(_file.absoluteFilePath()).name();
+        ApplicationItem *item = m_associations->defaultApplication(mime);
+        // the same arguments as for explicitly selected files
+        QVariantHash args;
+        args["%f"] = _file.absoluteFilePath();
+        args["%F"] = QStringList(_file.absoluteFilePath());
+        args["%u"] = url.toString();
+        args["%U"] = QStringList(url.toString());
+        if ((item) && (item->launch(args)))
+            return true;
+        qCInfo(LOG_LIB) << "Could not launch default application for" << mime;
+    }
 
     return QDesktopServices::openUrl(url);
 }
+
+
+/**
+ * @fn searchEntries
+ */
+int FileManagerCore::searchEntries(const QString &_directory,
+                                   const QString &_substr, const bool _hidden)
+{
+    qCDebug(LOG_LIB) << "Directory" << _directory << "and show hidden"
+                     << _hidden << "substring" << _substr;
+
+    if (!QDir(_directory).exists()) {
+        qCCritical(LOG_LIB) << "Could not find directory" << _directory;
+        return -1;
+    }
+
+    int id = ++m_lastRequest;
+    if (m_index->covers(_directory)) {
+        // index answers immediately, but signals are queued to keep the same
+        // behaviour as for background search
+        QFileInfoList entries = m_index->search(_directory, _substr, _hidden,
+                                                m_excludes, m_searchDepth);
+        for (int i = 0; i < entries.count(); i += FILEMANAGER_CHUNK_SIZE)
+            QMetaObject::invokeMethod(
+                this, "entriesReceived", Qt::QueuedConnection, Q_ARG(int, id),
+                Q_ARG(QFileInfoList, entries.mid(i, FILEMANAGER_CHUNK_SIZE)));
+        QMetaObject::invokeMethod(this, "listingFinished",
+                                  Qt::QueuedConnection, Q_ARG(int, id),
+                                  Q_ARG(bool, false));
+        return id;
+    }
+
+    FileSystemWalker *walker
+        = new FileSystemWalker(this, id, _directory, _substr, _hidden);
+    walker->setExcludes(m_excludes);
+    walker->setMaxDepth(m_searchDepth);
+    m_walkers[id] = walker;
+
+    // walker signals are emitted from its threads, thus they are queued
+    connect(walker, SIGNAL(entriesFound(const int, const QFileInfoList &)),
+            this, SIGNAL(entriesReceived(const int, const QFileInfoList &)));
+    connect(walker, SIGNAL(finished(const int, const bool)), this,
+            SIGNAL(listingFinished(const int, const bool)));
+    connect(walker, SIGNAL(finished(const int, const bool)), this,
+            SLOT(removeRequest(const int)));
+    walker->start();
+
+    return id;
+}
+
+
+/**
+ * @fn removeRequest
+ */
+void FileManagerCore::removeRequest(const int _id)
+{
+    qCDebug(LOG_LIB) << "Remove request" << _id;
+
+    m_requests.remove(_id);
+    if (m_walkers.contains(_id))
+        m_walkers.take(_id)->deleteLater();
+}
@@ -0,0 +1,325 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file FileSystemWalker.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadrocore/Quadro.h"
+
+#include <QFile>
+#include <QRegExp>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+using namespace Quadro;
+
+
+/**
+ * @class FileSystemWalker
+ */
+/**
+ * @fn FileSystemWalker
+ */
+FileSystemWalker::FileSystemWalker(QObject *_parent, const int _id,
+                                   const QString &_directory,
+                                   const QString &_substr, const bool _hidden)
+    : QObject(_parent)
+    , m_directory(_directory)
+    , m_hidden(_hidden)
+    , m_id(_id)
+    , m_substr(_substr)
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    m_pool = new QThreadPool(this);
+}
+
+
+/**
+ * @fn ~FileSystemWalker
+ */
+FileSystemWalker::~FileSystemWalker()
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    cancel();
+    wait();
+    qDeleteAll(m_queues);
+}
+
+
+/**
+ * @fn nameMatcher
+ */
+QRegExp FileSystemWalker::nameMatcher(const QString &_substr)
+{
+    return QRegExp(QString("*%1*").arg(_substr), Qt::CaseInsensitive,
+                   QRegExp::Wildcard);
+}
+
+
+/**
+ * @fn prunedPaths
+ */
+QStringList FileSystemWalker::prunedPaths()
+{
+    return QStringList({"/proc", "/sys"});
+}
+
+
+/**
+ * @fn setExcludes
+ */
+void FileSystemWalker::setExcludes(const QStringList &_excludes)
+{
+    qCDebug(LOG_LIB) << "Exclude patterns" << _excludes;
+
+    m_excludes = _excludes;
+}
+
+
+/**
+ * @fn setMaxDepth
+ */
+void FileSystemWalker::setMaxDepth(const int _depth)
+{
+    qCDebug(LOG_LIB) << "Maximal depth" << _depth;
+
+    m_maxDepth = _depth;
+}
+
+
+/**
+ * @fn setSameFilesystem
+ */
+void FileSystemWalker::setSameFilesystem(const bool _sameFilesystem)
+{
+    qCDebug(LOG_LIB) << "Same filesystem" << _sameFilesystem;
+
+    m_sameFilesystem = _sameFilesystem;
+}
+
+
+/**
+ * @fn wait
+ */
+void FileSystemWalker::wait()
+{
+    m_pool->waitForDone();
+}
+
+
+/**
+ * @fn cancel
+ */
+void FileSystemWalker::cancel()
+{
+    qCDebug(LOG_LIB) << "Cancel search" << m_id;
+
+    m_cancelled.store(1);
+    m_wakeUp.wakeAll();
+}
+
+
+/**
+ * @fn start
+ */
+void FileSystemWalker::start()
+{
+    qCDebug(LOG_LIB) << "Start search" << m_id << "of" << m_substr << "in"
+                     << m_directory;
+
+    struct stat root;
+    if (::stat(QFile::encodeName(m_directory).constData(), &root) != 0) {
+        qCWarning(LOG_LIB) << "Could not read" << m_directory;
+        emit(finished(m_id, false));
+        return;
+    }
+    m_device = root.st_dev;
+
+    int count = std::max(1, QThread::idealThreadCount());
+    m_pool->setMaxThreadCount(count);
+    for (int i = 0; i < count; i++)
+        m_queues.append(new WorkQueue());
+
+    // root directory is the only job at the start
+    m_pending.store(1);
+    m_queues.first()->directories.push_back(
+        qMakePair(QFile::encodeName(m_directory), 0));
+    m_active.store(count);
+    for (int i = 0; i < count; i++)
+        QtConcurrent::run(m_pool, [this, i]() { work(i); });
+}
+
+
+/**
+ * @fn takeDirectory
+ */
+bool FileSystemWalker::takeDirectory(const int _index,
+                                     QPair<QByteArray, int> &_directory)
+{
+    forever {
+        if (m_cancelled.load())
+            return false;
+
+        // own queue first, the newest directory is used for locality
+        WorkQueue *own = m_queues.at(_index);
+        {
+            QMutexLocker locker(&own->lock);
+            if (!own->directories.empty()) {
+                _directory = own->directories.back();
+                own->directories.pop_back();
+                return true;
+            }
+        }
+        // steal the oldest directory from others, it usually has the largest
+        // subtree
+        for (int i = 1; i < m_queues.count(); i++) {
+            WorkQueue *queue = m_queues.at((_index + i) % m_queues.count());
+            QMutexLocker locker(&queue->lock);
+            if (queue->directories.empty())
+                continue;
+            _directory = queue->directories.front();
+            queue->directories.pop_front();
+            return true;
+        }
+
+        // nothing to do, check whether other workers may add anything
+        if (m_pending.load() == 0)
+            return false;
+        QMutexLocker locker(&m_wakeUpLock);
+        // timeout is used to avoid lost wake ups
+        m_wakeUp.wait(&m_wakeUpLock, 10);
+    }
+}
+
+
+/**
+ * @fn work
+ */
+void FileSystemWalker::work(const int _index)
+{
+    // QRegExp is not reentrant, thus each worker uses own copies
+    QList<QRegExp> excludes;
+    for (auto &pattern : m_excludes)
+        excludes.append(QRegExp(pattern, Qt::CaseSensitive, QRegExp::Wildcard));
+    QRegExp matcher = nameMatcher(m_substr);
+    QStringList pruned = prunedPaths();
+
+    QFileInfoList chunk;
+    QPair<QByteArray, int> current;
+    while (takeDirectory(_index, current)) {
+        QByteArray prefix = current.first.endsWith('/')
+                                ? current.first
+                                : current.first + '/';
+        DIR *dir = ::opendir(current.first.constData());
+        if (!dir) {
+            qCDebug(LOG_LIB) << "Could not open" << current.first;
+            if (!m_pending.deref())
+                m_wakeUp.wakeAll();
+            continue;
+        }
+
+        int fd = ::dirfd(dir);
+        while (struct dirent *entry = ::readdir(dir)) {
+            if (m_cancelled.load())
+                break;
+            QByteArray name = entry->d_name;
+            if ((name == ".") || (name == ".."))
+                continue;
+            if ((!m_hidden) && (name.startsWith('.')))
+                continue;
+
+            QString fileName = QFile::decodeName(name);
+            QString filePath = QFile::decodeName(prefix + name);
+            bool excluded = false;
+            for (auto &exclude : excludes) {
+                excluded = exclude.exactMatch(
+                    exclude.pattern().contains('/') ? filePath : fileName);
+                if (excluded)
+                    break;
+            }
+            if (excluded)
+                continue;
+
+            // stream found entries
+            if (matcher.exactMatch(fileName)) {
+                chunk.append(QFileInfo(filePath));
+                if (chunk.count() >= FILEMANAGER_CHUNK_SIZE) {
+                    emit(entriesFound(m_id, chunk));
+                    chunk.clear();
+                }
+            }
+
+            // check whether we should walk into
+            struct stat info;
+            bool hasInfo = false;
+            bool isDir = entry->d_type == DT_DIR;
+            if (entry->d_type == DT_UNKNOWN) {
+                hasInfo = ::fstatat(fd, entry->d_name, &info,
+                                    AT_SYMLINK_NOFOLLOW)
+                          == 0;
+                isDir = hasInfo && S_ISDIR(info.st_mode);
+            }
+            if (!isDir)
+                continue;
+            if ((m_maxDepth != -1) && (current.second >= m_maxDepth))
+                continue;
+            if (pruned.contains(filePath))
+                continue;
+            if (m_sameFilesystem) {
+                if ((!hasInfo)
+                    && (::fstatat(fd, entry->d_name, &info,
+                                  AT_SYMLINK_NOFOLLOW)
+                        != 0))
+                    continue;
+                if (static_cast<quint64>(info.st_dev) != m_device)
+                    continue;
+            }
+
+            m_pending.ref();
+            {
+                WorkQueue *own = m_queues.at(_index);
+                QMutexLocker locker(&own->lock);
+                own->directories.push_back(
+                    qMakePair(prefix + name, current.second + 1));
+            }
+            m_wakeUp.wakeOne();
+        }
+        ::closedir(dir);
+
+        if (!m_pending.deref())
+            m_wakeUp.wakeAll();
+    }
+
+    if (!chunk.isEmpty() && !m_cancelled.load())
+        emit(entriesFound(m_id, chunk));
+    // the last worker reports the end
+    if (!m_active.deref())
+        emit(finished(m_id, m_cancelled.load() != 0));
+}
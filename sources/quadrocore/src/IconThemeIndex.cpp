@@ -0,0 +1,615 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file IconThemeIndex.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadrocore/Quadro.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QIconEngine>
+#include <QMap>
+#include <QMutex>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QtEndian>
+
+#include <algorithm>
+#include <climits>
+
+using namespace Quadro;
+
+
+/**
+ * @brief read big endian 16-bit value from mapped index
+ */
+static quint16 read16(const uchar *_data, const quint32 _size,
+                      const quint64 _offset)
+{
+    if ((_offset > _size) || (_size - _offset < 2))
+        return 0xffff;
+    return qFromBigEndian<quint16>(_data + _offset);
+}
+
+
+/**
+ * @brief read big endian 32-bit value from mapped index
+ */
+static quint32 read32(const uchar *_data, const quint32 _size,
+                      const quint64 _offset)
+{
+    if ((_offset > _size) || (_size - _offset < 4))
+        return 0xffffffff;
+    return qFromBigEndian<quint32>(_data + _offset);
+}
+
+
+/**
+ * @brief read null-terminated string from mapped index
+ */
+static QByteArray readString(const uchar *_data, const quint32 _size,
+                             const quint64 _offset)
+{
+    if (_offset >= _size)
+        return QByteArray();
+    const char *string = reinterpret_cast<const char *>(_data + _offset);
+    uint length = qstrnlen(string, _size - _offset);
+    // string is not terminated
+    if (length == _size - _offset)
+        return QByteArray();
+
+    return QByteArray(string, length);
+}
+
+
+/**
+ * @brief append big endian values to generated index
+ */
+static void append16(QByteArray &_data, const quint16 _value)
+{
+    uchar value[2];
+    qToBigEndian(_value, value);
+    _data.append(reinterpret_cast<const char *>(value), 2);
+}
+static void append32(QByteArray &_data, const quint32 _value)
+{
+    uchar value[4];
+    qToBigEndian(_value, value);
+    _data.append(reinterpret_cast<const char *>(value), 4);
+}
+static void put32(QByteArray &_data, const int _offset, const quint32 _value)
+{
+    qToBigEndian(_value, reinterpret_cast<uchar *>(_data.data() + _offset));
+}
+
+
+/**
+ * @brief append null-terminated string aligned to 4 bytes
+ */
+static void appendString(QByteArray &_data, const QByteArray &_value)
+{
+    _data.append(_value);
+    _data.append('\0');
+    while (_data.size() % 4 != 0)
+        _data.append('\0');
+}
+
+
+/**
+ * @brief icon engine which keeps icon name for icons built from index
+ * @remark name is required by pixmap caches and icon comparison
+ */
+class NamedIconEngine : public QIconEngine
+{
+public:
+    NamedIconEngine(const QString &_name, const QIcon &_icon)
+        : QIconEngine()
+        , m_icon(_icon)
+        , m_name(_name)
+    {
+    }
+    QList<QSize> availableSizes(QIcon::Mode _mode, QIcon::State _state) const
+    {
+        return m_icon.availableSizes(_mode, _state);
+    }
+    QIconEngine *clone() const { return new NamedIconEngine(m_name, m_icon); }
+    QString iconName() const { return m_name; }
+    void paint(QPainter *_painter, const QRect &_rect, QIcon::Mode _mode,
+               QIcon::State _state)
+    {
+        m_icon.paint(_painter, _rect, Qt::AlignCenter, _mode, _state);
+    }
+    QPixmap pixmap(const QSize &_size, QIcon::Mode _mode, QIcon::State _state)
+    {
+        return m_icon.pixmap(_size, _mode, _state);
+    }
+
+private:
+    QIcon m_icon;
+    QString m_name;
+};
+
+
+/**
+ * @class IconThemeIndex
+ */
+/**
+ * @fn IconThemeIndex
+ */
+IconThemeIndex::IconThemeIndex(const QString &_theme,
+                               const QStringList &_searchPaths)
+    : m_searchPaths(_searchPaths)
+    , m_theme(_theme)
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    // inherited themes are loaded breadth-first, hicolor is always the last
+    QStringList themes = {m_theme};
+    int rank = 0;
+    while (rank < themes.count()) {
+        for (auto &parent : loadTheme(themes.at(rank), rank)) {
+            if ((parent != "hicolor") && (!themes.contains(parent)))
+                themes.append(parent);
+        }
+        rank++;
+    }
+    if (!themes.contains("hicolor"))
+        loadTheme("hicolor", rank);
+}
+
+
+/**
+ * @fn ~IconThemeIndex
+ */
+IconThemeIndex::~IconThemeIndex()
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    // files are unmapped on close
+    qDeleteAll(m_files);
+}
+
+
+/**
+ * @fn instance
+ */
+QSharedPointer<IconThemeIndex>
+IconThemeIndex::instance(const QString &_theme,
+                         const QStringList &_searchPaths)
+{
+    static QMutex lock;
+    static QHash<QString, QSharedPointer<IconThemeIndex>> indexes;
+
+    QString key = QString("%1:%2").arg(_theme).arg(_searchPaths.join(':'));
+    {
+        QMutexLocker locker(&lock);
+        if (indexes.contains(key))
+            return indexes[key];
+    }
+
+    // index is created without lock, thus other themes are not blocked
+    qCInfo(LOG_LIB) << "Create icon index for theme" << _theme;
+    QSharedPointer<IconThemeIndex> index(
+        new IconThemeIndex(_theme, _searchPaths));
+
+    QMutexLocker locker(&lock);
+    if (!indexes.contains(key))
+        indexes[key] = index;
+    return indexes[key];
+}
+
+
+/**
+ * @fn instance
+ */
+QSharedPointer<IconThemeIndex> IconThemeIndex::instance()
+{
+    return instance(QIcon::themeName(), QIcon::themeSearchPaths());
+}
+
+
+/**
+ * @fn icon
+ */
+QIcon IconThemeIndex::icon(const QString &_name) const
+{
+    if (QDir::isAbsolutePath(_name))
+        return QIcon(_name);
+
+    // foo-bar-baz falls back to foo-bar and foo
+    QString name = _name;
+    while (!name.isEmpty()) {
+        QList<Candidate> found = candidates(name);
+        if (!found.isEmpty()) {
+            QIcon icon;
+            for (auto &candidate : found) {
+                const Directory &directory
+                    = m_directories.at(candidate.directory);
+                if (directory.scalable)
+                    icon.addFile(candidate.path);
+                else
+                    icon.addFile(candidate.path,
+                                 QSize(directory.size, directory.size));
+            }
+            return QIcon(new NamedIconEngine(_name, icon));
+        }
+        int index = name.lastIndexOf('-');
+        name = index == -1 ? QString() : name.left(index);
+    }
+
+    QString path = lookup(_name, 0);
+    if (!path.isEmpty())
+        return QIcon(new NamedIconEngine(_name, QIcon(path)));
+
+    qCInfo(LOG_LIB) << "Icon" << _name << "is not indexed";
+    return QIcon::fromTheme(_name);
+}
+
+
+/**
+ * @fn lookup
+ */
+QString IconThemeIndex::lookup(const QString &_name, const int _size) const
+{
+    QString name = _name;
+    while (!name.isEmpty()) {
+        const Candidate *best = nullptr;
+        int bestDistance = INT_MAX;
+        int bestSize = 0;
+        QList<Candidate> found = candidates(name);
+        for (auto &candidate : found) {
+            const Directory &directory = m_directories.at(candidate.directory);
+            int distance = 0;
+            if (_size < directory.minSize)
+                distance = directory.minSize - _size;
+            else if (_size > directory.maxSize)
+                distance = _size - directory.maxSize;
+            // on the same distance the larger icon is preferred, it looks
+            // better after downscaling
+            if ((best) && ((distance > bestDistance)
+                           || ((distance == bestDistance)
+                               && (directory.maxSize <= bestSize))))
+                continue;
+            best = &candidate;
+            bestDistance = distance;
+            bestSize = directory.maxSize;
+        }
+        if (best)
+            return best->path;
+        int index = name.lastIndexOf('-');
+        name = index == -1 ? QString() : name.left(index);
+    }
+
+    // unthemed icons
+    for (auto &suffix : {"png", "svg", "xpm"}) {
+        QString path
+            = QString("/usr/share/pixmaps/%1.%2").arg(_name).arg(suffix);
+        if (QFile::exists(path))
+            return path;
+    }
+
+    return QString();
+}
+
+
+/**
+ * @fn theme
+ */
+QString IconThemeIndex::theme() const
+{
+    return m_theme;
+}
+
+
+/**
+ * @fn candidates
+ */
+QList<IconThemeIndex::Candidate>
+IconThemeIndex::candidates(const QString &_name) const
+{
+    QByteArray name = _name.toUtf8();
+    quint32 nameHash = hash(name);
+
+    QList<Candidate> found;
+    for (auto &cache : m_caches) {
+        // caches are sorted by rank
+        if ((!found.isEmpty()) && (found.first().rank < cache.rank))
+            break;
+
+        quint32 hashOffset = read32(cache.data, cache.size, 4);
+        quint32 buckets = read32(cache.data, cache.size, hashOffset);
+        if ((buckets == 0) || (buckets == 0xffffffff))
+            continue;
+        quint64 bucketOffset = hashOffset + 4ull + 4ull * (nameHash % buckets);
+        quint32 iconOffset = read32(cache.data, cache.size, bucketOffset);
+        // each icon takes 12 bytes at least, it prevents infinite loops
+        for (quint32 steps = 0;
+             (iconOffset != 0xffffffff) && (steps < cache.size / 12); steps++) {
+            quint32 nameOffset
+                = read32(cache.data, cache.size, iconOffset + 4ull);
+            if (readString(cache.data, cache.size, nameOffset) != name) {
+                iconOffset = read32(cache.data, cache.size, iconOffset);
+                continue;
+            }
+
+            quint32 listOffset
+                = read32(cache.data, cache.size, iconOffset + 8ull);
+            quint32 count = read32(cache.data, cache.size, listOffset);
+            if (count == 0xffffffff)
+                break;
+            for (quint32 i = 0; i < count; i++) {
+                quint64 imageOffset = listOffset + 4ull + 8ull * i;
+                quint16 directoryIndex
+                    = read16(cache.data, cache.size, imageOffset);
+                quint16 flags
+                    = read16(cache.data, cache.size, imageOffset + 2);
+                if ((directoryIndex == 0xffff) || (flags == 0xffff))
+                    break;
+                if (directoryIndex >= cache.directories.count())
+                    continue;
+                int directory = cache.directories.at(directoryIndex);
+                if (directory == -1)
+                    continue;
+
+                // flags are 1 for xpm, 2 for svg and 4 for png
+                QString suffix;
+                if ((m_directories.at(directory).scalable) && (flags & 2))
+                    suffix = "svg";
+                else if (flags & 4)
+                    suffix = "png";
+                else if (flags & 2)
+                    suffix = "svg";
+                else if (flags & 1)
+                    suffix = "xpm";
+                else
+                    continue;
+                found.append({cache.rank, directory,
+                              QString("%1/%2.%3")
+                                  .arg(m_directories.at(directory).path)
+                                  .arg(_name)
+                                  .arg(suffix)});
+            }
+            break;
+        }
+    }
+
+    return found;
+}
+
+
+/**
+ * @fn generate
+ */
+bool IconThemeIndex::generate(const QString &_root,
+                              const QStringList &_directories,
+                              const QString &_fileName)
+{
+    qCInfo(LOG_LIB) << "Generate icon index for" << _root;
+
+    // images of each icon as directory index and suffix flags
+    QHash<QByteArray, QMap<int, quint16>> icons;
+    for (int i = 0; i < _directories.count(); i++) {
+        QDir directory(QString("%1/%2").arg(_root).arg(_directories.at(i)));
+        for (auto &file : directory.entryInfoList(
+                 {"*.png", "*.svg", "*.xpm"}, QDir::Files)) {
+            QString suffix = file.suffix();
+            quint16 flag = suffix == "png" ? 4 : suffix == "svg" ? 2 : 1;
+            icons[file.completeBaseName().toUtf8()][i] |= flag;
+        }
+    }
+
+    // the same layout as GTK icon-theme.cache version 1.0 uses
+    QByteArray data;
+    append16(data, 1);
+    append16(data, 0);
+    append32(data, 0);
+    append32(data, 0);
+    // directory list
+    put32(data, 8, data.size());
+    append32(data, _directories.count());
+    int directoryTable = data.size();
+    data.append(QByteArray(4 * _directories.count(), '\0'));
+    for (int i = 0; i < _directories.count(); i++) {
+        put32(data, directoryTable + 4 * i, data.size());
+        appendString(data, _directories.at(i).toUtf8());
+    }
+    // hash table, empty buckets are marked by 0xffffffff
+    put32(data, 4, data.size());
+    quint32 buckets = std::max(1, icons.count());
+    append32(data, buckets);
+    int bucketTable = data.size();
+    data.append(QByteArray(4 * buckets, '\xff'));
+    for (auto icon = icons.cbegin(); icon != icons.cend(); ++icon) {
+        int bucket = bucketTable + 4 * (hash(icon.key()) % buckets);
+        int iconOffset = data.size();
+        append32(data, qFromBigEndian<quint32>(
+                           reinterpret_cast<const uchar *>(data.constData())
+                           + bucket));
+        append32(data, 0);
+        append32(data, 0);
+        put32(data, bucket, iconOffset);
+        put32(data, iconOffset + 4, data.size());
+        appendString(data, icon.key());
+        put32(data, iconOffset + 8, data.size());
+        append32(data, icon.value().count());
+        for (auto image = icon.value().cbegin(); image != icon.value().cend();
+             ++image) {
+            append16(data, image.key());
+            append16(data, image.value());
+            append32(data, 0);
+        }
+    }
+
+    QDir().mkpath(QFileInfo(_fileName).absolutePath());
+    QSaveFile file(_fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(LOG_LIB) << "Could not open file" << _fileName;
+        return false;
+    }
+    file.write(data);
+
+    return file.commit();
+}
+
+
+/**
+ * @fn hash
+ */
+quint32 IconThemeIndex::hash(const QByteArray &_name)
+{
+    if (_name.isEmpty())
+        return 0;
+
+    // GTK uses signed chars here
+    quint32 value = static_cast<signed char>(_name.at(0));
+    for (int i = 1; i < _name.size(); i++)
+        value = (value << 5) - value + static_cast<signed char>(_name.at(i));
+
+    return value;
+}
+
+
+/**
+ * @fn map
+ */
+bool IconThemeIndex::map(const QString &_fileName, const int _rank,
+                         const QHash<QString, int> &_directories)
+{
+    qCDebug(LOG_LIB) << "Map icon index" << _fileName;
+
+    QFile *file = new QFile(_fileName);
+    uchar *data = nullptr;
+    if (file->open(QIODevice::ReadOnly))
+        data = file->map(0, file->size());
+    if ((!data) || (file->size() < 12) || (file->size() > UINT_MAX)
+        || (read16(data, file->size(), 0) != 1)) {
+        qCWarning(LOG_LIB) << "Could not map icon index" << _fileName;
+        delete file;
+        return false;
+    }
+
+    Cache cache;
+    cache.rank = _rank;
+    cache.data = data;
+    cache.size = file->size();
+    quint32 listOffset = read32(data, cache.size, 8);
+    quint32 count = read32(data, cache.size, listOffset);
+    for (quint32 i = 0; (count != 0xffffffff) && (i < count); i++) {
+        quint32 offset
+            = read32(data, cache.size, listOffset + 4ull + 4ull * i);
+        if (offset == 0xffffffff)
+            break;
+        QString directory
+            = QString::fromUtf8(readString(data, cache.size, offset));
+        cache.directories.append(_directories.value(directory, -1));
+    }
+
+    m_caches.append(cache);
+    m_files.append(file);
+    return true;
+}
+
+
+/**
+ * @fn loadTheme
+ */
+QStringList IconThemeIndex::loadTheme(const QString &_theme, const int _rank)
+{
+    qCDebug(LOG_LIB) << "Load theme" << _theme << "with rank" << _rank;
+
+    QStringList parents;
+    for (auto &searchPath : m_searchPaths) {
+        QString root = QString("%1/%2").arg(searchPath).arg(_theme);
+        QString indexFile = QString("%1/index.theme").arg(root);
+        if (!QFile::exists(indexFile))
+            continue;
+
+        QSettings index(indexFile, QSettings::IniFormat);
+        index.beginGroup("Icon Theme");
+        QStringList names = index.value("Directories").toStringList();
+        if (parents.isEmpty())
+            parents = index.value("Inherits").toStringList();
+        index.endGroup();
+
+        // index is outdated if any directory is newer than it
+        QDateTime modified = QFileInfo(root).lastModified();
+        QHash<QString, int> directories;
+        for (auto &name : names) {
+            QFileInfo info(QString("%1/%2").arg(root).arg(name));
+            if (!info.isDir())
+                continue;
+            modified = std::max(modified, info.lastModified());
+
+            index.beginGroup(name);
+            Directory directory;
+            directory.path = info.absoluteFilePath();
+            directory.size = index.value("Size").toInt();
+            QString type = index.value("Type", "Threshold").toString();
+            directory.scalable = type == "Scalable";
+            directory.minSize = directory.size;
+            directory.maxSize = directory.size;
+            if (type == "Scalable") {
+                directory.minSize
+                    = index.value("MinSize", directory.size).toInt();
+                directory.maxSize
+                    = index.value("MaxSize", directory.size).toInt();
+            } else if (type == "Threshold") {
+                int threshold = index.value("Threshold", 2).toInt();
+                directory.minSize -= threshold;
+                directory.maxSize += threshold;
+            }
+            index.endGroup();
+
+            directories[name] = m_directories.count();
+            m_directories.append(directory);
+        }
+
+        QString fileName = QString("%1/icon-theme.cache").arg(root);
+        QFileInfo cacheInfo(fileName);
+        if ((cacheInfo.exists()) && (cacheInfo.lastModified() >= modified)
+            && (map(fileName, _rank, directories)))
+            continue;
+
+        // generated index is stored by hash of theme path
+        fileName = QString("%1/%2/%3/%4.cache")
+                       .arg(QStandardPaths::writableLocation(
+                           QStandardPaths::GenericCacheLocation))
+                       .arg(HOME_PATH)
+                       .arg(ICON_INDEX_PATH)
+                       .arg(QString::fromLatin1(
+                           QCryptographicHash::hash(root.toUtf8(),
+                                                    QCryptographicHash::Md5)
+                               .toHex()));
+        cacheInfo.setFile(fileName);
+        if ((!cacheInfo.exists()) || (cacheInfo.lastModified() < modified)) {
+            if (!generate(root, directories.keys(), fileName))
+                continue;
+        }
+        map(fileName, _rank, directories);
+    }
+
+    return parents;
+}
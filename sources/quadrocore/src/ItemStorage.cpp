@@ -0,0 +1,617 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file ItemStorage.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadrocore/Quadro.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QSettings>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStandardPaths>
+
+using namespace Quadro;
+
+
+/**
+ * @class ItemStorage
+ */
+/**
+ * @fn ItemStorage
+ */
+ItemStorage::ItemStorage(QObject *_parent, const QString &_category,
+                         const QString &_legacyPath)
+    : QObject(_parent)
+    , m_category(_category)
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    m_connection = QString("quadro-storage-%1-%2")
+                       .arg(m_category)
+                       .arg(reinterpret_cast<quintptr>(this));
+    QDir().mkpath(QFileInfo(databasePath()).absolutePath());
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", m_connection);
+    db.setDatabaseName(databasePath());
+    // database may be locked by another instance for a while
+    db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=1000");
+    if (!db.open()) {
+        qCCritical(LOG_LIB) << "Could not open database" << databasePath()
+                            << db.lastError().text();
+        return;
+    }
+    if (!initSchema())
+        return;
+
+    // import items from the legacy layout once
+    if (isImported())
+        return;
+    qCInfo(LOG_LIB) << "Import" << m_category << "from" << _legacyPath;
+    // items and import flag are written together, thus the import will be
+    // either completed or repeated on the next start
+    if (!db.transaction()) {
+        qCWarning(LOG_LIB) << "Could not start transaction"
+                           << db.lastError().text();
+        return;
+    }
+    if ((readDesktops(_legacyPath) == -1) || (!setImported())) {
+        db.rollback();
+        return;
+    }
+    db.commit();
+}
+
+
+/**
+ * @fn ~ItemStorage
+ */
+ItemStorage::~ItemStorage()
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    // database object should be destroyed before connection removal
+    {
+        QSqlDatabase db = database();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(m_connection);
+}
+
+
+/**
+ * @fn addItem
+ */
+bool ItemStorage::addItem(const ApplicationItem *_item, const int _position)
+{
+    qCDebug(LOG_LIB) << "Add item" << _item->name() << "to" << m_category
+                     << "at" << _position;
+
+    QSqlDatabase db = database();
+    if (!db.transaction()) {
+        qCWarning(LOG_LIB) << "Could not start transaction"
+                           << db.lastError().text();
+        return false;
+    }
+
+    if (!writeItem(_item, _position, QDateTime::currentMSecsSinceEpoch())) {
+        db.rollback();
+        return false;
+    }
+
+    return db.commit();
+}
+
+
+/**
+ * @fn addItems
+ */
+bool ItemStorage::addItems(const QList<QPair<ApplicationItem *, qint64>> &_items)
+{
+    qCDebug(LOG_LIB) << "Add" << _items.count() << "items to" << m_category;
+
+    QSqlDatabase db = database();
+    if (!db.transaction()) {
+        qCWarning(LOG_LIB) << "Could not start transaction"
+                           << db.lastError().text();
+        return false;
+    }
+
+    for (auto &item : _items) {
+        if (writeItem(item.first, -1, item.second))
+            continue;
+        db.rollback();
+        return false;
+    }
+
+    return db.commit();
+}
+
+
+/**
+ * @fn category
+ */
+QString ItemStorage::category() const
+{
+    return m_category;
+}
+
+
+/**
+ * @fn contains
+ */
+bool ItemStorage::contains(const QString &_name) const
+{
+    QSqlQuery query(database());
+    query.prepare("SELECT 1 FROM items WHERE category = ? AND name = ?");
+    query.addBindValue(m_category);
+    query.addBindValue(_name);
+    if (!query.exec()) {
+        qCWarning(LOG_LIB) << "Could not find item" << _name
+                           << query.lastError().text();
+        return false;
+    }
+
+    return query.next();
+}
+
+
+/**
+ * @fn databasePath
+ */
+QString ItemStorage::databasePath()
+{
+    QString homePath = QString("%1/%2")
+                           .arg(QStandardPaths::writableLocation(
+                               QStandardPaths::GenericDataLocation))
+                           .arg(HOME_PATH);
+
+    return QString("%1/%2").arg(homePath).arg(STORAGE_FILE);
+}
+
+
+/**
+ * @fn exportDesktops
+ */
+int ItemStorage::exportDesktops(const QString &_path) const
+{
+    qCDebug(LOG_LIB) << "Export" << m_category << "to" << _path;
+
+    if (!QDir().mkpath(_path)) {
+        qCWarning(LOG_LIB) << "Could not create" << _path;
+        return -1;
+    }
+
+    QStringList order;
+    QList<ApplicationItem *> exported = items(nullptr);
+    for (auto item : exported) {
+        if (item->saveDesktop(_path).isEmpty())
+            qCWarning(LOG_LIB) << "Could not export" << item->name();
+        else
+            order.append(item->name());
+        delete item;
+    }
+
+    QSettings settings(QFileInfo(QDir(_path), "index.conf").filePath(),
+                       QSettings::IniFormat);
+    settings.setIniCodec("UTF-8");
+    settings.setValue("Order", order);
+    settings.sync();
+
+    return order.count();
+}
+
+
+/**
+ * @fn importDesktops
+ */
+int ItemStorage::importDesktops(const QString &_path)
+{
+    qCDebug(LOG_LIB) << "Import" << m_category << "from" << _path;
+
+    QSqlDatabase db = database();
+    if (!db.transaction()) {
+        qCWarning(LOG_LIB) << "Could not start transaction"
+                           << db.lastError().text();
+        return -1;
+    }
+
+    int count = readDesktops(_path);
+    if (count == -1) {
+        db.rollback();
+        return -1;
+    }
+
+    return db.commit() ? count : -1;
+}
+
+
+/**
+ * @fn isValid
+ */
+bool ItemStorage::isValid() const
+{
+    return database().isOpen();
+}
+
+
+/**
+ * @fn items
+ */
+QList<ApplicationItem *> ItemStorage::items(QObject *_parent) const
+{
+    QList<ApplicationItem *> found;
+
+    QSqlQuery query(database());
+    query.prepare("SELECT properties FROM items WHERE category = ? "
+                  "ORDER BY position, modified");
+    query.addBindValue(m_category);
+    if (!query.exec()) {
+        qCWarning(LOG_LIB) << "Could not read" << m_category
+                           << query.lastError().text();
+        return found;
+    }
+
+    while (query.next()) {
+        QVariantHash properties;
+        QDataStream stream(query.value(0).toByteArray());
+        stream >> properties;
+        found.append(ApplicationItem::fromHash(properties, _parent));
+    }
+
+    return found;
+}
+
+
+/**
+ * @fn namesByTime
+ */
+QStringList ItemStorage::namesByTime() const
+{
+    QStringList names;
+
+    QSqlQuery query(database());
+    query.prepare(
+        "SELECT name FROM items WHERE category = ? ORDER BY modified");
+    query.addBindValue(m_category);
+    if (!query.exec()) {
+        qCWarning(LOG_LIB) << "Could not read" << m_category
+                           << query.lastError().text();
+        return names;
+    }
+
+    while (query.next())
+        names.append(query.value(0).toString());
+
+    return names;
+}
+
+
+/**
+ * @fn removeItem
+ */
+bool ItemStorage::removeItem(const QString &_name)
+{
+    qCDebug(LOG_LIB) << "Remove item" << _name << "from" << m_category;
+
+    QSqlQuery query(database());
+    query.prepare("DELETE FROM items WHERE category = ? AND name = ?");
+    query.addBindValue(m_category);
+    query.addBindValue(_name);
+    if (!query.exec()) {
+        qCWarning(LOG_LIB) << "Could not remove item" << _name
+                           << query.lastError().text();
+        return false;
+    }
+
+    return query.numRowsAffected() > 0;
+}
+
+
+/**
+ * @fn rotate
+ */
+int ItemStorage::rotate(const int _count)
+{
+    qCDebug(LOG_LIB) << "Keep" << _count << "items in" << m_category;
+
+    QSqlQuery query(database());
+    query.prepare("DELETE FROM items WHERE category = ? AND name NOT IN "
+                  "(SELECT name FROM items WHERE category = ? "
+                  "ORDER BY modified DESC LIMIT ?)");
+    query.addBindValue(m_category);
+    query.addBindValue(m_category);
+    query.addBindValue(_count);
+    if (!query.exec()) {
+        qCWarning(LOG_LIB) << "Could not rotate" << m_category
+                           << query.lastError().text();
+        return -1;
+    }
+
+    return query.numRowsAffected();
+}
+
+
+/**
+ * @fn setOrder
+ */
+bool ItemStorage::setOrder(const QStringList &_order)
+{
+    qCDebug(LOG_LIB) << "Set order" << _order << "in" << m_category;
+
+    QSqlDatabase db = database();
+    if (!db.transaction()) {
+        qCWarning(LOG_LIB) << "Could not start transaction"
+                           << db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.prepare(
+        "UPDATE items SET position = ? WHERE category = ? AND name = ?");
+    for (int i = 0; i < _order.count(); i++) {
+        query.addBindValue(i);
+        query.addBindValue(m_category);
+        query.addBindValue(_order.at(i));
+        if (query.exec())
+            continue;
+        qCWarning(LOG_LIB) << "Could not update position of" << _order.at(i)
+                           << query.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    return db.commit();
+}
+
+
+/**
+ * @fn setValue
+ */
+bool ItemStorage::setValue(const QString &_key, const QVariant &_value)
+{
+    qCDebug(LOG_LIB) << "Set" << _key << "to" << _value << "in" << m_category;
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << _value;
+
+    QSqlQuery query(database());
+    query.prepare("INSERT OR REPLACE INTO state (category, key, value) "
+                  "VALUES (?, ?, ?)");
+    query.addBindValue(m_category);
+    query.addBindValue(_key);
+    query.addBindValue(data);
+    if (!query.exec()) {
+        qCWarning(LOG_LIB) << "Could not save value" << _key
+                           << query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @fn updateItem
+ */
+bool ItemStorage::updateItem(const ApplicationItem *_item)
+{
+    qCDebug(LOG_LIB) << "Update item" << _item->name() << "in" << m_category;
+
+    QByteArray properties;
+    QDataStream stream(&properties, QIODevice::WriteOnly);
+    stream << _item->toHash();
+
+    QSqlQuery query(database());
+    query.prepare("UPDATE items SET properties = ? "
+                  "WHERE category = ? AND name = ?");
+    query.addBindValue(properties);
+    query.addBindValue(m_category);
+    query.addBindValue(_item->name());
+    if (!query.exec()) {
+        qCWarning(LOG_LIB) << "Could not update item" << _item->name()
+                           << query.lastError().text();
+        return false;
+    }
+
+    return query.numRowsAffected() > 0;
+}
+
+
+/**
+ * @fn value
+ */
+QVariant ItemStorage::value(const QString &_key,
+                            const QVariant &_default) const
+{
+    QSqlQuery query(database());
+    query.prepare("SELECT value FROM state WHERE category = ? AND key = ?");
+    query.addBindValue(m_category);
+    query.addBindValue(_key);
+    if (!query.exec() || !query.next())
+        return _default;
+
+    QVariant value;
+    QDataStream stream(query.value(0).toByteArray());
+    stream >> value;
+
+    return value;
+}
+
+
+/**
+ * @fn database
+ */
+QSqlDatabase ItemStorage::database() const
+{
+    return QSqlDatabase::database(m_connection, false);
+}
+
+
+/**
+ * @fn initSchema
+ */
+bool ItemStorage::initSchema()
+{
+    QStringList statements
+        = {"CREATE TABLE IF NOT EXISTS items (category TEXT NOT NULL, "
+           "name TEXT NOT NULL, position INTEGER NOT NULL, "
+           "modified INTEGER NOT NULL, properties BLOB NOT NULL, "
+           "PRIMARY KEY (category, name))",
+           "CREATE INDEX IF NOT EXISTS items_position ON items "
+           "(category, position)",
+           "CREATE INDEX IF NOT EXISTS items_modified ON items "
+           "(category, modified)",
+           "CREATE TABLE IF NOT EXISTS imports (category TEXT PRIMARY KEY)",
+           "CREATE TABLE IF NOT EXISTS state (category TEXT NOT NULL, "
+           "key TEXT NOT NULL, value BLOB NOT NULL, "
+           "PRIMARY KEY (category, key))"};
+
+    QSqlQuery query(database());
+    for (auto &statement : statements) {
+        if (query.exec(statement))
+            continue;
+        qCCritical(LOG_LIB) << "Could not init schema"
+                            << query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @fn isImported
+ */
+bool ItemStorage::isImported() const
+{
+    QSqlQuery query(database());
+    query.prepare("SELECT 1 FROM imports WHERE category = ?");
+    query.addBindValue(m_category);
+
+    return query.exec() && query.next();
+}
+
+
+/**
+ * @fn readDesktops
+ */
+int ItemStorage::readDesktops(const QString &_path)
+{
+    QDir directory(_path);
+    QSettings settings(QFileInfo(directory, "index.conf").filePath(),
+                       QSettings::IniFormat);
+    settings.setIniCodec("UTF-8");
+    QStringList order = settings.value("Order").toStringList();
+
+    int count = 0;
+    QFileInfoList entries
+        = directory.entryInfoList(QStringList("*.desktop"), QDir::Files);
+    for (auto &entry : entries) {
+        qCInfo(LOG_LIB) << "Desktop" << entry.filePath();
+        ApplicationItem *item
+            = ApplicationItem::fromDesktop(entry.filePath(), nullptr);
+        int position = order.indexOf(item->name());
+        if (position == -1)
+            position = order.count() + count;
+        bool status = writeItem(item, position,
+                                entry.lastModified().toMSecsSinceEpoch());
+        delete item;
+        if (!status)
+            return -1;
+        count++;
+    }
+
+    return count;
+}
+
+
+/**
+ * @fn setImported
+ */
+bool ItemStorage::setImported()
+{
+    QSqlQuery query(database());
+    query.prepare("INSERT OR REPLACE INTO imports (category) VALUES (?)");
+    query.addBindValue(m_category);
+    if (!query.exec()) {
+        qCWarning(LOG_LIB) << "Could not mark" << m_category << "as imported"
+                           << query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @fn writeItem
+ */
+bool ItemStorage::writeItem(const ApplicationItem *_item, const int _position,
+                            const qint64 _modified)
+{
+    QSqlDatabase db = database();
+    int position = _position;
+    if (position == -1) {
+        // keep position of the existing item or place it to the end
+        QSqlQuery query(db);
+        query.prepare("SELECT COALESCE((SELECT position FROM items "
+                      "WHERE category = ? AND name = ?), "
+                      "(SELECT MAX(position) + 1 FROM items "
+                      "WHERE category = ?), 0)");
+        query.addBindValue(m_category);
+        query.addBindValue(_item->name());
+        query.addBindValue(m_category);
+        if (!query.exec() || !query.next()) {
+            qCWarning(LOG_LIB) << "Could not find position for"
+                               << _item->name() << query.lastError().text();
+            return false;
+        }
+        position = query.value(0).toInt();
+    }
+
+    QByteArray properties;
+    QDataStream stream(&properties, QIODevice::WriteOnly);
+    stream << _item->toHash();
+
+    QSqlQuery query(db);
+    query.prepare("INSERT OR REPLACE INTO items "
+                  "(category, name, position, modified, properties) "
+                  "VALUES (?, ?, ?, ?, ?)");
+    query.addBindValue(m_category);
+    query.addBindValue(_item->name());
+    query.addBindValue(position);
+    query.addBindValue(_modified);
+    query.addBindValue(properties);
+    if (!query.exec()) {
+        qCWarning(LOG_LIB) << "Could not write item" << _item->name()
+                           << query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
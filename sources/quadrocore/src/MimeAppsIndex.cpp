@@ -0,0 +1,288 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file MimeAppsIndex.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadrocore/Quadro.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QMimeDatabase>
+#include <QStandardPaths>
+#include <QTextStream>
+
+using namespace Quadro;
+
+
+/**
+ * @class MimeAppsIndex
+ */
+/**
+ * @fn MimeAppsIndex
+ */
+MimeAppsIndex::MimeAppsIndex(QObject *_parent, AbstractAppAggregator *_source)
+    : QObject(_parent)
+    , m_source(_source)
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn ~MimeAppsIndex
+ */
+MimeAppsIndex::~MimeAppsIndex()
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn application
+ */
+ApplicationItem *MimeAppsIndex::application(const QString &_desktopName)
+{
+    qCDebug(LOG_LIB) << "Desktop name" << _desktopName;
+
+    update();
+    if (m_applications.value(_desktopName))
+        return m_applications[_desktopName];
+
+    QString path = QStandardPaths::locate(QStandardPaths::ApplicationsLocation,
+                                          _desktopName);
+    // kde4-foo.desktop may be placed as kde4/foo.desktop
+    if ((path.isEmpty()) && (_desktopName.contains('-'))) {
+        QString name = _desktopName;
+        name[name.indexOf('-')] = '/';
+        path = QStandardPaths::locate(QStandardPaths::ApplicationsLocation,
+                                      name);
+    }
+    if (path.isEmpty()) {
+        qCInfo(LOG_LIB) << "Application" << _desktopName << "is not installed";
+        return nullptr;
+    }
+
+    ApplicationItem *item = ApplicationItem::fromDesktop(path, this);
+    m_applications[_desktopName] = item;
+
+    return item;
+}
+
+
+/**
+ * @fn applications
+ */
+QStringList MimeAppsIndex::applications(const QString &_mimeType)
+{
+    qCDebug(LOG_LIB) << "MIME type" << _mimeType;
+
+    update();
+
+    QMimeDatabase database;
+    QStringList types = {_mimeType};
+    types.append(database.mimeTypeForName(_mimeType).allAncestors());
+    QStringList desktops;
+    for (auto &type : types) {
+        for (auto &desktop : m_associations.value(type)) {
+            if (!desktops.contains(desktop))
+                desktops.append(desktop);
+        }
+    }
+
+    return desktops;
+}
+
+
+/**
+ * @fn defaultApplication
+ */
+ApplicationItem *MimeAppsIndex::defaultApplication(const QString &_mimeType)
+{
+    // the first installed application is the default one
+    for (auto &desktop : applications(_mimeType)) {
+        ApplicationItem *item = application(desktop);
+        if (item)
+            return item;
+    }
+
+    return nullptr;
+}
+
+
+/**
+ * @fn mimeAppsFiles
+ */
+QStringList MimeAppsIndex::mimeAppsFiles()
+{
+    QStringList desktops
+        = QString::fromLocal8Bit(qgetenv("XDG_CURRENT_DESKTOP"))
+              .toLower()
+              .split(':', QString::SkipEmptyParts);
+    QStringList directories = QStandardPaths::standardLocations(
+        QStandardPaths::GenericConfigLocation);
+    directories.append(QStandardPaths::standardLocations(
+        QStandardPaths::ApplicationsLocation));
+
+    QStringList files;
+    for (auto &directory : directories) {
+        for (auto &desktop : desktops)
+            files.append(
+                QString("%1/%2-mimeapps.list").arg(directory).arg(desktop));
+        files.append(QString("%1/mimeapps.list").arg(directory));
+    }
+
+    return files;
+}
+
+
+/**
+ * @fn mimeInfoFiles
+ */
+QStringList MimeAppsIndex::mimeInfoFiles()
+{
+    QStringList files;
+    for (auto &directory : QStandardPaths::standardLocations(
+             QStandardPaths::ApplicationsLocation))
+        files.append(QString("%1/mimeinfo.cache").arg(directory));
+
+    return files;
+}
+
+
+/**
+ * @fn readGroups
+ */
+QHash<QString, QHash<QString, QStringList>>
+MimeAppsIndex::readGroups(const QString &_fileName)
+{
+    QHash<QString, QHash<QString, QStringList>> groups;
+    QFile file(_fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return groups;
+
+    // QSettings does not keep ";" separated values, thus file is parsed here
+    QString group;
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    while (!stream.atEnd()) {
+        QString line = stream.readLine().trimmed();
+        if ((line.isEmpty()) || (line.startsWith('#')))
+            continue;
+        if ((line.startsWith('[')) && (line.endsWith(']'))) {
+            group = line.mid(1, line.length() - 2);
+            continue;
+        }
+        int index = line.indexOf('=');
+        if (index == -1)
+            continue;
+        groups[group][line.left(index).trimmed()]
+            = line.mid(index + 1).split(';', QString::SkipEmptyParts);
+    }
+
+    return groups;
+}
+
+
+/**
+ * @fn update
+ */
+void MimeAppsIndex::update()
+{
+    bool outdated = m_generation != m_source->generation();
+    for (auto file = m_files.cbegin(); (!outdated) && (file != m_files.cend());
+         ++file)
+        outdated = QFileInfo(file.key()).lastModified() != file.value();
+    if (!outdated)
+        return;
+
+    qCInfo(LOG_LIB) << "Rebuild MIME associations for generation"
+                    << m_source->generation();
+    // applications which have been read from desktop files are owned here
+    for (auto &item : m_applications) {
+        if ((item) && (item->parent() == this))
+            item->deleteLater();
+    }
+    m_applications.clear();
+    m_associations.clear();
+    m_files.clear();
+
+    // the first file is the most important, removed associations of the
+    // more important file override added associations of the less one
+    QHash<QString, QStringList> defaults;
+    QHash<QString, QStringList> added;
+    QHash<QString, QStringList> removed;
+    for (auto &fileName : mimeAppsFiles()) {
+        m_files[fileName] = QFileInfo(fileName).lastModified();
+        QHash<QString, QHash<QString, QStringList>> groups
+            = readGroups(fileName);
+        // defaults of the less important file are used as fallback, e.g. if
+        // the preferred application is not installed
+        QHash<QString, QStringList> group = groups["Default Applications"];
+        for (auto type = group.cbegin(); type != group.cend(); ++type) {
+            for (auto &desktop : type.value()) {
+                if (!defaults[type.key()].contains(desktop))
+                    defaults[type.key()].append(desktop);
+            }
+        }
+        group = groups["Added Associations"];
+        for (auto type = group.cbegin(); type != group.cend(); ++type) {
+            for (auto &desktop : type.value()) {
+                if ((!removed[type.key()].contains(desktop))
+                    && (!added[type.key()].contains(desktop)))
+                    added[type.key()].append(desktop);
+            }
+        }
+        group = groups["Removed Associations"];
+        for (auto type = group.cbegin(); type != group.cend(); ++type)
+            removed[type.key()].append(type.value());
+    }
+
+    // catalogue applications and then system caches
+    QHash<QString, QStringList> installed;
+    for (auto item : m_source->applications()) {
+        m_applications[item->desktopName()] = item;
+        for (auto &type : item->mimeType())
+            installed[type].append(item->desktopName());
+    }
+    for (auto &fileName : mimeInfoFiles()) {
+        m_files[fileName] = QFileInfo(fileName).lastModified();
+        QHash<QString, QStringList> group
+            = readGroups(fileName)["MIME Cache"];
+        for (auto type = group.cbegin(); type != group.cend(); ++type)
+            installed[type.key()].append(type.value());
+    }
+
+    QStringList types = defaults.keys() + added.keys() + installed.keys();
+    types.removeDuplicates();
+    for (auto &type : types) {
+        QStringList desktops = defaults.value(type) + added.value(type);
+        for (auto &desktop : installed.value(type)) {
+            if (!removed.value(type).contains(desktop))
+                desktops.append(desktop);
+        }
+        desktops.removeDuplicates();
+        m_associations[type] = desktops;
+    }
+    m_generation = m_source->generation();
+}
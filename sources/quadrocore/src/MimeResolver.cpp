@@ -0,0 +1,159 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file MimeResolver.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadrocore/Quadro.h"
+
+#include <QFile>
+
+#include <sys/stat.h>
+
+using namespace Quadro;
+
+
+/**
+ * @class MimeResolver
+ */
+/**
+ * @fn MimeResolver
+ */
+MimeResolver::MimeResolver(QObject *_parent)
+    : QObject(_parent)
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    m_cache.setMaxCost(MIME_CACHE_SIZE);
+}
+
+
+/**
+ * @fn ~MimeResolver
+ */
+MimeResolver::~MimeResolver()
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn database
+ */
+const QMimeDatabase &MimeResolver::database() const
+{
+    return m_database;
+}
+
+
+/**
+ * @fn mimeType
+ */
+QMimeType MimeResolver::mimeType(const QString &_file,
+                                 const QMimeDatabase::MatchMode _mode)
+{
+    qCDebug(LOG_LIB) << "File" << _file << "with mode" << _mode;
+
+    struct stat info;
+    if (::stat(QFile::encodeName(_file).constData(), &info) != 0) {
+        qCInfo(LOG_LIB) << "Could not stat" << _file << "skip cache";
+        return m_database.mimeTypeForFile(_file, _mode);
+    }
+    // extension matching does not check file type, thus special files are
+    // detected here
+    QString special = specialType(info.st_mode);
+    if (!special.isEmpty())
+        return m_database.mimeTypeForName(special);
+
+    QByteArray key;
+    key.reserve(4 * sizeof(qint64));
+    for (qint64 value :
+         {static_cast<qint64>(info.st_dev), static_cast<qint64>(info.st_ino),
+          static_cast<qint64>(info.st_mtim.tv_sec),
+          static_cast<qint64>(info.st_mtim.tv_nsec)})
+        key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+
+    {
+        QMutexLocker locker(&m_lock);
+        Result *result = m_cache.object(key);
+        if ((result) && (isSuitable(*result, _mode))) {
+            QMimeType type = m_database.mimeTypeForName(result->name);
+            if (type.isValid())
+                return type;
+        }
+    }
+
+    // detection itself is done without lock, database is thread-safe
+    QMimeType type = m_database.mimeTypeForFile(_file, _mode);
+    qCDebug(LOG_LIB) << "Mime type" << type.name();
+
+    QMutexLocker locker(&m_lock);
+    m_cache.insert(key, new Result{type.name(), _mode});
+
+    return type;
+}
+
+
+/**
+ * @fn isSuitable
+ */
+bool MimeResolver::isSuitable(const Result &_result,
+                              const QMimeDatabase::MatchMode _mode) const
+{
+    if (_result.mode == _mode)
+        return true;
+
+    switch (_mode) {
+    case QMimeDatabase::MatchExtension:
+        // any result is at least as good as extension based one
+        return true;
+    case QMimeDatabase::MatchDefault:
+        // extension based result is used unless extension was unknown
+        return (_result.mode == QMimeDatabase::MatchContent)
+               || (!m_database.mimeTypeForName(_result.name).isDefault());
+    case QMimeDatabase::MatchContent:
+        return false;
+    }
+
+    return false;
+}
+
+
+/**
+ * @fn specialType
+ */
+QString MimeResolver::specialType(const unsigned int _mode)
+{
+    if (S_ISDIR(_mode))
+        return "inode/directory";
+    else if (S_ISCHR(_mode))
+        return "inode/chardevice";
+    else if (S_ISBLK(_mode))
+        return "inode/blockdevice";
+    else if (S_ISFIFO(_mode))
+        return "inode/fifo";
+    else if (S_ISSOCK(_mode))
+        return "inode/socket";
+
+    return QString();
+}
@@ -92,6 +92,15 @@ QStringList PluginCore::desktopPaths()
 }
 
 
+/**
+ * @fn generation
+ */
+uint PluginCore::generation() const
+{
+    return m_generation;
+}
+
+
 /**
  * @fn initPlugin
  */
@@ -204,6 +213,8 @@ void PluginCore::initPlugins()
             m_allPlugins[repr->name()] = repr;
         }
     }
+
+    m_generation++;
 }
 
 
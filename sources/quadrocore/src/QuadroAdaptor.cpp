@@ -41,6 +41,38 @@ QuadroAdaptor::QuadroAdaptor(QuadroCore *_core)
     , m_core(_core)
 {
     qCDebug(LOG_DBUS) << __PRETTY_FUNCTION__;
+
+    // relay change notifications
+    connect(m_core->launcher(),
+            SIGNAL(applicationsChanged(const uint, const QStringList &,
+                                       const QStringList &,
+                                       const QStringList &)),
+            this, SIGNAL(ApplicationsChanged(const uint, const QStringList &,
+                                             const QStringList &,
+                                             const QStringList &)));
+    connect(m_core->documents(),
+            SIGNAL(applicationsChanged(const uint, const QStringList &,
+                                       const QStringList &,
+                                       const QStringList &)),
+            this, SIGNAL(DocumentsChanged(const uint, const QStringList &,
+                                          const QStringList &,
+                                          const QStringList &)));
+    connect(m_core->documents(), SIGNAL(itemChanged(const QString &)), this,
+            SIGNAL(DocumentChanged(const QString &)));
+    connect(m_core->favorites(),
+            SIGNAL(applicationsChanged(const uint, const QStringList &,
+                                       const QStringList &,
+                                       const QStringList &)),
+            this, SIGNAL(FavoritesChanged(const uint, const QStringList &,
+                                          const QStringList &,
+                                          const QStringList &)));
+    connect(m_core->recently(),
+            SIGNAL(applicationsChanged(const uint, const QStringList &,
+                                       const QStringList &,
+                                       const QStringList &)),
+            this, SIGNAL(RecentChanged(const uint, const QStringList &,
+                                       const QStringList &,
+                                       const QStringList &)));
 }
 
 
@@ -53,6 +85,79 @@ QuadroAdaptor::~QuadroAdaptor()
 }
 
 
+/**
+ * @fn Applications
+ */
+QList<ApplicationMetadata> QuadroAdaptor::Applications() const
+{
+    uint generation = m_core->launcher()->generation();
+    if (generation == m_applicationsGeneration)
+        return m_applications;
+
+    qCInfo(LOG_DBUS) << "Rebuild applications reply for generation"
+                     << generation;
+    m_applications.clear();
+    // map is already sorted by name
+    for (auto app : m_core->launcher()->applications().values()) {
+        ApplicationMetadata metadata;
+        metadata.name = app->name();
+        metadata.genericName = app->genericName();
+        metadata.comment = app->comment();
+        metadata.icon = app->icon();
+        metadata.exec = app->exec();
+        metadata.desktopName = app->desktopName();
+        metadata.categories = app->categories();
+        metadata.keywords = app->keywords();
+        m_applications.append(metadata);
+    }
+    m_applicationsGeneration = generation;
+
+    return m_applications;
+}
+
+
+/**
+ * @fn Catalogue
+ */
+QDBusUnixFileDescriptor QuadroAdaptor::Catalogue() const
+{
+    if (!QDBusUnixFileDescriptor::isSupported()) {
+        qCWarning(LOG_DBUS) << "File descriptor passing is not supported";
+        return QDBusUnixFileDescriptor();
+    }
+
+    int fd = m_core->catalogue()->fileDescriptor();
+    if (fd == -1) {
+        qCWarning(LOG_DBUS) << "Could not publish catalogue";
+        return QDBusUnixFileDescriptor();
+    }
+
+    // descriptor will be duplicated, thus snapshot keeps its own one
+    return QDBusUnixFileDescriptor(fd);
+}
+
+
+/**
+ * @fn ExportItems
+ */
+bool QuadroAdaptor::ExportItems(const QString &path) const
+{
+    qCDebug(LOG_DBUS) << "Export items to" << path;
+
+    QList<ItemStorage *> storages = {m_core->documents()->storage(),
+                                     m_core->favorites()->storage(),
+                                     m_core->recently()->storage()};
+    bool status = true;
+    for (auto storage : storages) {
+        QString directory
+            = QString("%1/%2").arg(path).arg(storage->category());
+        status &= storage->exportDesktops(directory) != -1;
+    }
+
+    return status;
+}
+
+
 /**
  * @fn Favorites
  */
@@ -62,6 +167,21 @@ QStringList QuadroAdaptor::Favorites() const
 }
 
 
+/**
+ * @fn Generations
+ */
+QVariantHash QuadroAdaptor::Generations() const
+{
+    QVariantHash generations;
+    generations["applications"] = m_core->launcher()->generation();
+    generations["documents"] = m_core->documents()->generation();
+    generations["favorites"] = m_core->favorites()->generation();
+    generations["recent"] = m_core->recently()->generation();
+
+    return generations;
+}
+
+
 /**
  * @fn Icon
  */
@@ -73,6 +193,17 @@ QString QuadroAdaptor::Icon(const QString &file) const
 }
 
 
+/**
+ * @fn Icons
+ */
+QStringList QuadroAdaptor::Icons(const QStringList &files) const
+{
+    qCDebug(LOG_DBUS) << "File names" << files;
+
+    return m_core->filemanager()->iconNamesByFileNames(files);
+}
+
+
 /**
  * @fn IsKnownPlatform
  */
@@ -93,30 +224,64 @@ QString QuadroAdaptor::MIME(const QString &file) const
 }
 
 
+/**
+ * @fn MIMEs
+ */
+QStringList QuadroAdaptor::MIMEs(const QStringList &files) const
+{
+    qCDebug(LOG_DBUS) << "File names" << files;
+
+    QStringList mimes;
+    for (auto &mime : m_core->filemanager()->mimesByFileNames(files))
+        mimes.append(mime.name());
+
+    return mimes;
+}
+
+
+/**
+ * @fn MoveFavorite
+ */
+void QuadroAdaptor::MoveFavorite(const QString &name, const int index) const
+{
+    qCDebug(LOG_DBUS) << "Move favorite" << name << "to" << index;
+
+    m_core->favorites()->moveApplication(name, index);
+}
+
+
 /**
  * @fn Plugins
  */
-QDBusVariant QuadroAdaptor::Plugins(const QString &group) const
+QList<PluginMetadata> QuadroAdaptor::Plugins(const QString &group) const
 {
     qCDebug(LOG_DBUS) << "Plugin group" << group;
 
-    QHash<QString, PluginRepresentation *> plugins
-        = m_core->plugin()->knownPlugins(group);
-
-    QVariantList data;
-    for (auto plugin : plugins.values()) {
-        QVariantHash metadata;
-        metadata["author"] = plugin->author();
-        metadata["comment"] = plugin->comment();
-        metadata["group"] = plugin->group();
-        metadata["location"] = plugin->location();
-        metadata["name"] = plugin->name();
-        metadata["url"] = plugin->url();
-        metadata["version"] = plugin->version();
+    uint generation = m_core->plugin()->generation();
+    if (generation != m_pluginsGeneration) {
+        qCInfo(LOG_DBUS) << "Drop plugins replies for generation"
+                         << m_pluginsGeneration;
+        m_plugins.clear();
+        m_pluginsGeneration = generation;
+    }
+    if (m_plugins.contains(group))
+        return m_plugins[group];
+
+    QList<PluginMetadata> data;
+    for (auto plugin : m_core->plugin()->knownPlugins(group).values()) {
+        PluginMetadata metadata;
+        metadata.author = plugin->author();
+        metadata.comment = plugin->comment();
+        metadata.group = plugin->group();
+        metadata.location = plugin->location();
+        metadata.name = plugin->name();
+        metadata.url = plugin->url();
+        metadata.version = plugin->version();
         data.append(metadata);
     }
+    m_plugins[group] = data;
 
-    return QDBusVariant(QVariant(data));
+    return data;
 }
 
 
@@ -134,7 +299,11 @@ QStringList QuadroAdaptor::Recent() const
  */
 QStringList QuadroAdaptor::RecentDocuments() const
 {
-    return m_core->documents()->recent();
+    QStringList documents = m_core->documents()->recent();
+    // items are going to be shown, resolve missing icons in background
+    m_core->documents()->resolveIcons(documents);
+
+    return documents;
 }
 
 
@@ -49,10 +49,20 @@ QuadroCore::QuadroCore(QObject *_parent)
         this, m_config->property("RecentItemsCount").toInt());
     m_documents->initApplications();
     m_favorites = new FavoritesCore(this);
+    FavoritesCore::setInstance(m_favorites);
     m_favorites->initApplications();
     m_filemanager = new FileManagerCore(this);
+    m_filemanager->setSearchRules(
+        m_config->property("SearchExcludes").toStringList(),
+        m_config->property("SearchDepth").toInt());
+    m_filemanager->setIndexRoots(
+        m_config->property("IndexRoots").toStringList());
+    m_documents->setMimeResolver(m_filemanager->mimeResolver());
     m_launcher = new LauncherCore(this);
     m_launcher->initApplications();
+    m_catalogue = new CatalogueSnapshot(this, m_launcher);
+    m_associations = new MimeAppsIndex(this, m_launcher);
+    m_filemanager->setAssociations(m_associations);
     m_plugin = new PluginCore(this);
     m_plugin->initPlugins();
     m_recently = new RecentlyCore(
@@ -76,6 +86,8 @@ QuadroCore::~QuadroCore()
     QDBusConnection::sessionBus().unregisterObject(DBUS_OBJECT_PATH);
     QDBusConnection::sessionBus().unregisterService(DBUS_SERVICE);
 
+    delete m_associations;
+    delete m_catalogue;
     delete m_config;
     delete m_documents;
     delete m_favorites;
@@ -87,6 +99,24 @@ QuadroCore::~QuadroCore()
 }
 
 
+/**
+ * @fn associations
+ */
+MimeAppsIndex *QuadroCore::associations()
+{
+    return m_associations;
+}
+
+
+/**
+ * @fn catalogue
+ */
+CatalogueSnapshot *QuadroCore::catalogue()
+{
+    return m_catalogue;
+}
+
+
 /**
  * @fn config
  */
@@ -164,6 +194,9 @@ RecentlyCore *QuadroCore::recently()
  */
 void QuadroCore::createDBusSession()
 {
+    // custom types must be known before adaptors will be exported
+    DBusTypes::registerTypes();
+
     QDBusConnection bus = QDBusConnection::sessionBus();
     if (!bus.registerService(DBUS_SERVICE)) {
         qCWarning(LOG_UI) << "Could not register service";
@@ -25,7 +25,6 @@
 
 #include "quadrocore/Quadro.h"
 
-#include <QDir>
 #include <QStandardPaths>
 
 using namespace Quadro;
@@ -42,6 +41,8 @@ RecentlyCore::RecentlyCore(QObject *_parent, const int _recentItems)
     , m_recentItems(_recentItems)
 {
     qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    m_storage = new ItemStorage(this, RECENT_PATH, desktopPath());
 }
 
 
@@ -92,33 +93,38 @@ QString RecentlyCore::desktopPath()
  */
 QMap<QString, ApplicationItem *> RecentlyCore::getApplicationsFromDesktops()
 {
-    QStringList filter("*.desktop");
     QMap<QString, ApplicationItem *> items;
-
-    QStringList entries
-        = QDir(desktopPath()).entryList(filter, QDir::Files, QDir::Time);
-    for (auto &entry : entries) {
-        QString desktop = QFileInfo(QDir(desktopPath()), entry).filePath();
-        qCInfo(LOG_LIB) << "Desktop" << desktop;
-        ApplicationItem *item = ApplicationItem::fromDesktop(desktop, this);
+    for (auto item : m_storage->items(this))
         items[item->name()] = item;
-        m_modifications.append(item->name());
-    }
 
     return items;
 }
 
 
+/**
+ * @fn order
+ */
+QStringList RecentlyCore::order() const
+{
+    return m_modifications;
+}
+
+
 /**
  * @fn recent
  */
 QStringList RecentlyCore::recent() const
 {
-    QStringList apps;
-    for (auto item : applications())
-        apps.append(item->name());
+    return order();
+}
 
-    return apps;
+
+/**
+ * @fn storage
+ */
+ItemStorage *RecentlyCore::storage() const
+{
+    return m_storage;
 }
 
 
@@ -129,20 +135,32 @@ ApplicationItem *RecentlyCore::addItem(ApplicationItem *_item)
 {
     qCDebug(LOG_LIB) << "Item name" << _item->name();
 
-    rotate();
     QDateTime modification = QDateTime::currentDateTime();
 
     _item->setComment(modification.toString(Qt::ISODate));
     _item->setIcon("emblem-favorites");
 
-    if (_item->saveDesktop(desktopPath()).isEmpty()) {
-        qCCritical(LOG_LIB) << "Could not save" << _item->desktopName();
+    if (!m_storage->addItem(_item)) {
+        qCCritical(LOG_LIB) << "Could not save" << _item->name();
         return nullptr;
     }
-    initApplications();
 
-    _item->deleteLater();
-    return applications()[_item->name()];
+    // update in-memory data without rescan
+    QString name = _item->name();
+    QStringList previous = order();
+    if (hasApplication(name) && (applications()[name] != _item)) {
+        ApplicationItem *item = applications()[name];
+        removeApplication(item);
+        item->deleteLater();
+    }
+    _item->setParent(this);
+    addApplication(_item);
+    m_modifications.removeAll(name);
+    m_modifications.append(name);
+    rotate();
+    notifyChanges(previous);
+
+    return _item;
 }
 
 
@@ -165,6 +183,8 @@ ApplicationItem *RecentlyCore::addItem(const QString &_name)
  */
 void RecentlyCore::initApplications()
 {
+    QStringList previous = order();
+
     // start cleanup
     dropApplications();
     m_modifications.clear();
@@ -172,9 +192,12 @@ void RecentlyCore::initApplications()
     QMap<QString, ApplicationItem *> desktops = getApplicationsFromDesktops();
     for (auto desktop : desktops.values())
         addApplication(desktop);
+    m_modifications = m_storage->namesByTime();
 
     // cleanup
     desktops.clear();
+
+    notifyChanges(previous);
 }
 
 
@@ -190,11 +213,8 @@ void RecentlyCore::removeItemByName(const QString &_name)
         return;
     }
 
-    QFile desktop(QString("%1/%2")
-                      .arg(desktopPath())
-                      .arg(applications()[_name]->desktopName()));
-    if (!desktop.remove()) {
-        qCCritical(LOG_LIB) << "Could not remove" << desktop.fileName();
+    if (!m_storage->removeItem(_name)) {
+        qCCritical(LOG_LIB) << "Could not remove" << _name;
         return;
     }
 
@@ -214,13 +234,15 @@ void RecentlyCore::touchItem(const QString &_name)
         return;
     }
 
+    QStringList previous = order();
     QDateTime modification = QDateTime::currentDateTime();
     applications()[_name]->setComment(modification.toString(Qt::ISODate));
 
-    applications()[_name]->saveDesktop(desktopPath());
+    m_storage->addItem(applications()[_name]);
     // update order
     int index = m_modifications.indexOf(_name);
     m_modifications.move(index, m_modifications.count() - 1);
+    notifyChanges(previous);
 }
 
 
@@ -229,10 +251,20 @@ void RecentlyCore::touchItem(const QString &_name)
  */
 void RecentlyCore::rotate()
 {
-    if (applications().count() <= m_recentItems) {
+    int removed = m_storage->rotate(m_recentItems);
+    if (removed <= 0) {
         qCInfo(LOG_LIB) << "Nothing to do here";
         return;
     }
 
-    return removeItemByName(m_modifications.first());
+    qCInfo(LOG_LIB) << "Removed" << removed << "outdated items";
+    // keep in-memory data in sync with the storage
+    while (m_modifications.count() > m_recentItems) {
+        QString name = m_modifications.takeFirst();
+        if (!hasApplication(name))
+            continue;
+        ApplicationItem *item = applications()[name];
+        removeApplication(item);
+        item->deleteLater();
+    }
 }
@@ -146,23 +146,60 @@ void StandaloneApplicationItem::updateWidgets()
     }
 
     // check if there is a known plugin
-    QVariantList check
-        = DBusOperations::sendRequestToLibrary("IsKnownPlatform");
-    if ((check.isEmpty()) || (!check.at(0).toBool())) {
-        qCCritical(LOG_LIB) << "No known platform found";
-        return;
-    }
+    DBusOperations::onReply(
+        DBusOperations::sendRequestToLibraryAsync("IsKnownPlatform"), this,
+        [this](const QVariantList &_reply) {
+            if ((_reply.isEmpty()) || (!_reply.at(0).toBool())) {
+                qCCritical(LOG_LIB) << "No known platform found";
+                return;
+            }
+            requestWindows();
+        });
+}
+
+
+/**
+ * @fn finished
+ */
+void StandaloneApplicationItem::finished(const int _exitCode,
+                                         const QProcess::ExitStatus _exitStatus)
+{
+    qCDebug(LOG_LIB) << "Exit code" << _exitCode << "Exit status"
+                     << _exitStatus;
+
+    m_widgets.clear();
+    return emit(close());
+}
 
+
+/**
+ * @fn requestWindows
+ */
+void StandaloneApplicationItem::requestWindows()
+{
     // get window list
-    QVariantList resp = DBusOperations::sendRequestToLibrary(
-        "WIdForPID", QVariantList() << processId());
-    if (resp.isEmpty()) {
-        qCCritical(LOG_LIB) << "Received empty response object";
-        return;
-    }
+    DBusOperations::onReply(
+        DBusOperations::sendRequestToLibraryAsync(
+            "WIdForPID", QVariantList() << processId()),
+        this, [this](const QVariantList &_reply) {
+            if (_reply.isEmpty()) {
+                qCCritical(LOG_LIB) << "Received empty response object";
+                return;
+            }
+            createWidgets(_reply.at(0).toStringList());
+        });
+}
+
+
+/**
+ * @fn createWidgets
+ */
+void StandaloneApplicationItem::createWidgets(const QStringList &_windows)
+{
+    qCDebug(LOG_LIB) << "Windows" << _windows;
 
     QList<WId> windows;
-    for (auto &strId : resp.at(0).toStringList())
+    for (auto &strId : _windows)
         windows.append(strId.toInt());
     if (windows.isEmpty()) {
         qCWarning(LOG_LIB) << "Could not find window for PID" << processId();
@@ -178,17 +215,3 @@ void StandaloneApplicationItem::updateWidgets()
 
     return emit(ready());
 }
-
-
-/**
- * @fn finished
- */
-void StandaloneApplicationItem::finished(const int _exitCode,
-                                         const QProcess::ExitStatus _exitStatus)
-{
-    qCDebug(LOG_LIB) << "Exit code" << _exitCode << "Exit status"
-                     << _exitStatus;
-
-    m_widgets.clear();
-    return emit(close());
-}
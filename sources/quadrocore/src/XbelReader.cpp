@@ -0,0 +1,229 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file XbelReader.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadrocore/Quadro.h"
+
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QStandardPaths>
+#include <QXmlStreamReader>
+
+#include <algorithm>
+
+using namespace Quadro;
+
+
+/**
+ * @class XbelReader
+ */
+/**
+ * @fn XbelReader
+ */
+XbelReader::XbelReader(QObject *_parent, const QString &_path,
+                       ItemStorage *_storage)
+    : QObject(_parent)
+    , m_path(_path)
+    , m_storage(_storage)
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+
+    m_watcher = new QFileSystemWatcher(this);
+    if (QFile::exists(m_path))
+        m_watcher->addPath(m_path);
+    connect(m_watcher, SIGNAL(fileChanged(const QString &)), this,
+            SLOT(fileChanged(const QString &)));
+}
+
+
+/**
+ * @fn ~XbelReader
+ */
+XbelReader::~XbelReader()
+{
+    qCDebug(LOG_LIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn defaultPath
+ */
+QString XbelReader::defaultPath()
+{
+    return QString("%1/%2")
+        .arg(QStandardPaths::writableLocation(
+            QStandardPaths::GenericDataLocation))
+        .arg(XBEL_FILE);
+}
+
+
+/**
+ * @fn read
+ */
+QList<XbelReader::Bookmark> XbelReader::read()
+{
+    QList<Bookmark> bookmarks;
+
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCInfo(LOG_LIB) << "Could not open" << m_path;
+        return bookmarks;
+    }
+
+    // check whether we may continue from the saved position
+    qint64 offset = m_storage->value("XbelOffset", 0).toLongLong();
+    QByteArray root;
+    if (offset > 0) {
+        root = rootElement(file);
+        if (root.isEmpty() || (offset > file.size())
+            || (signature(file, offset)
+                != m_storage->value("XbelSignature").toByteArray())) {
+            qCInfo(LOG_LIB) << "File has been changed, read it from start";
+            offset = 0;
+        }
+    }
+
+    QXmlStreamReader reader;
+    if (offset > 0)
+        reader.addData(root);
+    file.seek(offset);
+    qCInfo(LOG_LIB) << "Read" << m_path << "from" << offset;
+
+    Bookmark current;
+    bool inBookmark = false;
+    forever {
+        while (!reader.atEnd()) {
+            reader.readNext();
+            if (reader.isStartElement()) {
+                if (reader.name() == "bookmark") {
+                    current = Bookmark();
+                    current.href
+                        = reader.attributes().value("href").toString();
+                    current.modified = QDateTime::fromString(
+                        reader.attributes().value("modified").toString(),
+                        Qt::ISODate);
+                    inBookmark = true;
+                } else if (inBookmark && (reader.name() == "mime-type")) {
+                    current.mimeType
+                        = reader.attributes().value("type").toString();
+                }
+            } else if (reader.isEndElement() && (reader.name() == "bookmark")) {
+                bookmarks.append(current);
+                inBookmark = false;
+            }
+        }
+        // feed the next chunk if any
+        if ((reader.error() != QXmlStreamReader::PrematureEndOfDocumentError)
+            || file.atEnd())
+            break;
+        reader.addData(file.read(XBEL_CHUNK_SIZE));
+    }
+
+    if (reader.hasError()) {
+        qCWarning(LOG_LIB) << "Error while reading" << m_path
+                           << reader.errorString();
+        return bookmarks;
+    }
+
+    // save position for the next read
+    offset = lastBookmarkOffset(file);
+    m_storage->setValue("XbelOffset", offset);
+    m_storage->setValue("XbelSignature", signature(file, offset));
+    qCInfo(LOG_LIB) << "Found" << bookmarks.count() << "bookmarks, next read"
+                    << "from" << offset;
+
+    return bookmarks;
+}
+
+
+/**
+ * @fn fileChanged
+ */
+void XbelReader::fileChanged(const QString &_path)
+{
+    qCDebug(LOG_LIB) << "File changed" << _path;
+
+    // file is usually replaced on write, thus watcher should be set again
+    if (!m_watcher->files().contains(m_path) && QFile::exists(m_path))
+        m_watcher->addPath(m_path);
+
+    emit(changed());
+}
+
+
+/**
+ * @fn lastBookmarkOffset
+ */
+qint64 XbelReader::lastBookmarkOffset(QFile &_file) const
+{
+    static const QByteArray tag = "</bookmark>";
+
+    // read file from the end by chunks
+    qint64 end = _file.size();
+    while (end > 0) {
+        qint64 start = std::max<qint64>(0, end - XBEL_CHUNK_SIZE);
+        _file.seek(start);
+        QByteArray chunk = _file.read(end - start + tag.size());
+        int index = chunk.lastIndexOf(tag);
+        if (index != -1)
+            return start + index + tag.size();
+        end = start;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @fn rootElement
+ */
+QByteArray XbelReader::rootElement(QFile &_file) const
+{
+    _file.seek(0);
+    QByteArray chunk = _file.read(XBEL_CHUNK_SIZE);
+
+    int start = chunk.indexOf("<xbel");
+    if (start == -1)
+        return QByteArray();
+    int end = chunk.indexOf('>', start);
+    if (end == -1)
+        return QByteArray();
+
+    return chunk.left(end + 1);
+}
+
+
+/**
+ * @fn signature
+ */
+QByteArray XbelReader::signature(QFile &_file, const qint64 _offset) const
+{
+    static const qint64 size = 256;
+
+    qint64 start = std::max<qint64>(0, _offset - size);
+    _file.seek(start);
+
+    return _file.read(_offset - start);
+}
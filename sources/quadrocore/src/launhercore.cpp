@@ -121,6 +121,8 @@ QMap<QString, ApplicationItem *> LauncherCore::getApplicationsFromDesktops()
  */
 void LauncherCore::initApplications()
 {
+    QStringList previous = applications().keys();
+
     // start cleanup
     dropApplications();
     m_applicationsFromPaths.clear();
@@ -135,6 +137,8 @@ void LauncherCore::initApplications()
 
     // cleanup
     desktops.clear();
+
+    notifyChanges(previous);
 }
 
 
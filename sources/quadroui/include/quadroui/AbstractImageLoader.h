@@ -0,0 +1,191 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file AbstractImageLoader.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef ABSTRACTIMAGELOADER_H
+#define ABSTRACTIMAGELOADER_H
+
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QPointer>
+
+
+class QThreadPool;
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The AbstractImageLoader class provides queue of background image
+ * requests
+ * @remark requests are processed from the newest one, requests of widgets
+ * which are not visible at the moment they would be started are dropped.
+ * Images are loaded in worker threads by load() method
+ */
+class AbstractImageLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief AbstractImageLoader class constructor
+     * @param _parent pointer to parent object
+     * @param _threads count of worker threads
+     */
+    explicit AbstractImageLoader(QObject *_parent, const int _threads);
+
+    /**
+     * @brief AbstractImageLoader class destructor
+     */
+    virtual ~AbstractImageLoader();
+
+    /**
+     * @brief check whether there is queued or running request of receiver
+     * @param _receiver pointer to receiver
+     * @return true if request is queued or running
+     */
+    bool isPending(QObject *_receiver) const;
+
+    /**
+     * @brief request image
+     * @remark method of receiver will be invoked with QImage argument, the
+     * image is null if it could not be loaded. Nothing is invoked if request
+     * has been dropped, thus receiver may request it again
+     * @param _receiver pointer to receiver
+     * @param _method method name of receiver
+     * @param _source image source, e.g. file path
+     * @param _size maximal image size in device pixels
+     */
+    void request(QObject *_receiver, const char *_method,
+                 const QString &_source, const QSize &_size);
+
+    /**
+     * @brief request image for receiver which waits for several sources
+     * @remark method of receiver will be invoked with QString source and
+     * QImage arguments, otherwise it is the same as request()
+     * @param _receiver pointer to receiver
+     * @param _method method name of receiver
+     * @param _source image source, e.g. file path
+     * @param _size maximal image size in device pixels
+     */
+    void requestWithSource(QObject *_receiver, const char *_method,
+                           const QString &_source, const QSize &_size);
+
+public slots:
+    /**
+     * @brief cancel queued requests of receiver, result of running request
+     * will be ignored
+     * @param _receiver pointer to receiver
+     */
+    void cancel(QObject *_receiver);
+
+protected:
+    /**
+     * @brief load image
+     * @remark this method is called from worker threads
+     * @param _source image source
+     * @param _size maximal image size in device pixels
+     * @return loaded image or null image if it could not be loaded
+     */
+    virtual QImage load(const QString &_source, const QSize &_size) const = 0;
+
+    /**
+     * @brief drop queued requests and wait for running ones
+     * @remark this method must be called from destructor of derived class
+     */
+    void wait();
+
+private slots:
+    /**
+     * @brief send loaded image to receiver
+     * @param _id request id
+     * @param _image loaded image
+     */
+    void finished(const int _id, const QImage &_image);
+
+private:
+    /**
+     * @brief image request
+     */
+    struct Request {
+        /**
+         * @brief pointer to receiver
+         */
+        QPointer<QObject> receiver;
+        /**
+         * @brief method name of receiver
+         */
+        QByteArray method;
+        /**
+         * @brief image source
+         */
+        QString source;
+        /**
+         * @brief maximal image size
+         */
+        QSize size;
+        /**
+         * @brief pass source to receiver method or not
+         */
+        bool withSource;
+    };
+    /**
+     * @brief last used request id
+     */
+    int m_lastRequest = 0;
+    /**
+     * @brief thread pool for image loading
+     */
+    QThreadPool *m_pool = nullptr;
+    /**
+     * @brief queued requests, the last one will be started first
+     */
+    QList<Request> m_queue;
+    /**
+     * @brief running requests by id
+     */
+    QHash<int, Request> m_running;
+    /**
+     * @brief count of worker threads
+     */
+    int m_threads = 1;
+    // methods
+    /**
+     * @brief put request to queue
+     * @param _request image request
+     */
+    void enqueue(const Request &_request);
+    /**
+     * @brief start queued requests while there are free threads
+     */
+    void schedule();
+};
+};
+
+
+#endif /* ABSTRACTIMAGELOADER_H */
@@ -29,6 +29,7 @@
 #include "IconWidget.h"
 
 
+class QAction;
 class QMenu;
 
 /**
@@ -66,6 +67,14 @@ public:
      */
     ApplicationItem *associatedItem();
 
+    /**
+     * @brief bind widget to other item
+     * @remark this method is used to reuse widgets, only changed content is
+     * updated
+     * @param _appItem pointer to ApplicationItem
+     */
+    void setItem(ApplicationItem *_appItem);
+
 public slots:
 
     /**
@@ -140,9 +149,13 @@ private:
      */
     ApplicationItem *m_item = nullptr;
     /**
-     * @brief contextual menu
+     * @brief contextual menu, it is created on the first request
      */
     QMenu *m_menu = nullptr;
+    /**
+     * @brief favorites action in the contextual menu
+     */
+    QAction *m_favoritesAction = nullptr;
     /**
      * @brief command line arguments
      */
@@ -31,6 +31,7 @@
 #include "IconWidget.h"
 
 
+class QImage;
 class QMenu;
 
 /**
@@ -71,6 +72,22 @@ public:
      */
     virtual ~FileIconWidget();
 
+    /**
+     * @brief bind widget to other file
+     * @remark this method is used to reuse widgets, only changed content is
+     * updated
+     * @param _info associated QFileInfo object
+     * @param _icon icon from icon provider, it is not changed if null
+     */
+    void setFileInfo(const QFileInfo &_info, const QIcon &_icon);
+
+    /**
+     * @brief bind widget to other file
+     * @param _path associated file path
+     * @param _icon icon name
+     */
+    void setFileInfo(const QString &_path, const QString &_icon);
+
 public slots:
 
     /**
@@ -107,6 +124,14 @@ protected:
      */
     void mousePressEvent(QMouseEvent *_event);
 
+    /**
+     * @brief method which will be called to paint UI
+     * @remark thumbnail is requested on the first paint, thus only visible
+     * items request them
+     * @param _event pointer to paint event
+     */
+    void paintEvent(QPaintEvent *_event);
+
 private slots:
 
     /**
@@ -119,6 +144,12 @@ private slots:
      */
     void openRequested() const;
 
+    /**
+     * @brief set generated thumbnail as icon
+     * @param _image thumbnail image, icon is not changed if it is null
+     */
+    void setThumbnail(const QImage &_image);
+
     /**
      * @brief slot which will be called on entry properties request
      */
@@ -130,9 +161,17 @@ private:
      */
     QFileInfo m_info;
     /**
-     * @brief contextual menu
+     * @brief contextual menu, it is created on the first request
      */
     QMenu *m_menu = nullptr;
+    /**
+     * @brief is thumbnail request required or not
+     */
+    bool m_requireThumbnail = false;
+    /**
+     * @brief is thumbnail shown instead of icon or not
+     */
+    bool m_showThumbnail = false;
     // methods
     /**
      * @brief object create actions
@@ -81,15 +81,10 @@ private:
     FileInfoExtension m_item;
     // methods
     /**
-     * @brief get icon using main DBus interface
-     * @return icon object
+     * @brief request icon and MIME name using main DBus interface. The UI
+     * will be updated once replies will be received
      */
-    QIcon getIcon() const;
-
-    /**
-     * @brief get MIME name using main DBus interface
-     */
-    QString getMime() const;
+    void requestMetadata();
 };
 };
 
@@ -0,0 +1,154 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file IconAtlas.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef ICONATLAS_H
+#define ICONATLAS_H
+
+#include <QFile>
+#include <QHash>
+#include <QObject>
+#include <QPixmap>
+#include <QTimer>
+
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The IconAtlas class provides disk-backed storage of rasterized icons
+ * @remark there is an atlas file for each icon theme, icon size and device
+ * pixel ratio. Icons are stored by name together with icon file path and
+ * modification time. The file is memory mapped on creation and icon files are
+ * checked once at that time, outdated icons are dropped. New icons are kept
+ * in memory and appended to the file with delay. Methods should be called
+ * from GUI thread only
+ */
+class IconAtlas : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief IconAtlas class constructor
+     * @param _parent pointer to parent object
+     * @param _fileName path to atlas file
+     * @param _ratio device pixel ratio of stored icons
+     */
+    explicit IconAtlas(QObject *_parent, const QString &_fileName,
+                       const qreal _ratio);
+
+    /**
+     * @brief IconAtlas class destructor
+     */
+    virtual ~IconAtlas();
+
+    /**
+     * @brief shared atlas of icons with the specified size
+     * @param _size logical icon size
+     * @return pointer to atlas which is owned by application
+     */
+    static IconAtlas *instance(const QSize &_size);
+
+    /**
+     * @brief find stored icon
+     * @param _name icon name
+     * @param _pixmap found pixmap
+     * @return true if icon has been found
+     */
+    bool find(const QString &_name, QPixmap &_pixmap) const;
+
+    /**
+     * @brief store icon
+     * @param _name icon name
+     * @param _path path to icon file
+     * @param _image rasterized icon
+     */
+    void insert(const QString &_name, const QString &_path,
+                const QImage &_image);
+
+private slots:
+    /**
+     * @brief append new icons to atlas file
+     */
+    void save();
+
+private:
+    /**
+     * @brief stored icon
+     */
+    struct Entry {
+        /**
+         * @brief icon size in device pixels
+         */
+        QSize size;
+        /**
+         * @brief pointer to mapped premultiplied ARGB32 pixels, nullptr if
+         * icon has been stored in this session
+         */
+        const uchar *pixels = nullptr;
+        /**
+         * @brief icon which has been stored in this session
+         */
+        QImage image;
+        /**
+         * @brief record size
+         */
+        quint32 length = 0;
+    };
+    /**
+     * @brief stored icons by name
+     */
+    QHash<QString, Entry> m_entries;
+    /**
+     * @brief mapped atlas file
+     */
+    QFile m_file;
+    /**
+     * @brief records which are not saved yet
+     */
+    QByteArray m_pending;
+    /**
+     * @brief device pixel ratio of stored icons
+     */
+    qreal m_ratio = 1.0;
+    /**
+     * @brief timer which is used to delay saving
+     */
+    QTimer m_saveTimer;
+    // methods
+    /**
+     * @brief map atlas file and read records
+     * @remark records of changed icon files are dropped, file is rewritten if
+     * it contains too many outdated records
+     */
+    void load();
+};
+};
+
+
+#endif /* ICONATLAS_H */
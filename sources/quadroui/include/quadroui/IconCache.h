@@ -0,0 +1,104 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file IconCache.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef ICONCACHE_H
+#define ICONCACHE_H
+
+#include <QPixmap>
+
+
+class QIcon;
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The IconCache class provides process-wide cache of rasterized icons
+ * @remark pixmaps are cached by icon theme, icon name, pixel size and device
+ * pixel ratio. The least recently used pixmaps are dropped if cache exceeds
+ * @ref ICON_CACHE_SIZE. Methods should be called from GUI thread only
+ */
+class IconCache
+{
+public:
+    /**
+     * @brief drop all cached pixmaps
+     */
+    static void clear();
+
+    /**
+     * @brief find cached pixmap
+     * @param _name icon name
+     * @param _size logical pixmap size
+     * @param _pixmap found pixmap
+     * @return true if pixmap has been found
+     */
+    static bool find(const QString &_name, const QSize &_size,
+                     QPixmap &_pixmap);
+
+    /**
+     * @brief put pixmap to cache
+     * @remark this method may be used to cache pixmaps which have been loaded
+     * in background
+     * @param _name icon name
+     * @param _size logical pixmap size
+     * @param _pixmap rasterized pixmap
+     */
+    static void insert(const QString &_name, const QSize &_size,
+                       const QPixmap &_pixmap);
+
+    /**
+     * @brief get pixmap of icon
+     * @remark icons without names are not cached
+     * @param _icon icon object
+     * @param _size logical pixmap size
+     * @return rasterized pixmap
+     */
+    static QPixmap pixmap(const QIcon &_icon, const QSize &_size);
+
+    /**
+     * @brief get pixmap of icon from the current theme
+     * @param _name icon name
+     * @param _size logical pixmap size
+     * @return rasterized pixmap
+     */
+    static QPixmap pixmap(const QString &_name, const QSize &_size);
+
+private:
+    /**
+     * @brief cache key
+     * @param _name icon name
+     * @param _size logical pixmap size
+     * @return key of pixmap in cache
+     */
+    static QString key(const QString &_name, const QSize &_size);
+};
+};
+
+
+#endif /* ICONCACHE_H */
@@ -0,0 +1,100 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file IconLoader.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef ICONLOADER_H
+#define ICONLOADER_H
+
+#include <QStringList>
+
+#include "AbstractImageLoader.h"
+
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The IconLoader class provides background rasterization of theme
+ * icons
+ * @remark QIcon may not be used outside of GUI thread, thus icon files are
+ * looked up by IconThemeIndex and read by QImageReader. Icon theme is captured
+ * on loader creation
+ */
+class IconLoader : public AbstractImageLoader
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief IconLoader class constructor
+     * @param _parent pointer to parent object
+     */
+    explicit IconLoader(QObject *_parent);
+
+    /**
+     * @brief IconLoader class destructor
+     */
+    virtual ~IconLoader();
+
+    /**
+     * @brief shared loader instance
+     * @return pointer to loader which is owned by application
+     */
+    static IconLoader *instance();
+
+protected:
+    /**
+     * @brief find icon in theme and read it
+     * @remark path to icon file is set as "Source" text of the image
+     * @param _source icon name or absolute path to icon file
+     * @param _size maximal icon size in device pixels
+     * @return icon image or null image if icon could not be found
+     */
+    QImage load(const QString &_source, const QSize &_size) const;
+
+private:
+    /**
+     * @brief icon theme paths
+     */
+    QStringList m_searchPaths;
+    /**
+     * @brief icon theme name
+     */
+    QString m_theme;
+    // methods
+    /**
+     * @brief read image from file
+     * @param _path path to image file
+     * @param _size maximal image size
+     * @return image or null image if file could not be read
+     */
+    static QImage read(const QString &_path, const QSize &_size);
+};
+};
+
+
+#endif /* ICONLOADER_H */
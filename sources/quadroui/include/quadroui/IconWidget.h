@@ -26,13 +26,15 @@
 #ifndef ICONWIDGET_H
 #define ICONWIDGET_H
 
+#include <QPixmap>
 #include <QSize>
+#include <QStringList>
 #include <QWidget>
 
 
 class QIcon;
+class QImage;
 class QKeyEvent;
-class QLabel;
 class QMouseEvent;
 
 /**
@@ -42,6 +44,8 @@ namespace Quadro
 {
 /**
  * @brief The IconWidget class provides generic UI representation
+ * @remark icon, text and focus state are painted by widget itself, colors are
+ * taken from widget palette
  */
 class IconWidget : public QWidget
 {
@@ -65,20 +69,49 @@ public:
      * @param _size source size
      * @return converted QSize object
      */
-    inline QSize convertSize(const QSize &_size) const;
+    QSize convertSize(const QSize &_size) const;
+
+    /**
+     * @brief pixmap which is shown while icon is being loaded
+     * @param _size logical pixmap size
+     * @return placeholder pixmap
+     */
+    static QPixmap placeholder(const QSize &_size);
 
     /**
      * @brief set icon to UI
+     * @remark icon is not updated if it has the same name as the current one
      * @param _icon new icon object
      */
     void setIcon(const QIcon &_icon);
 
+    /**
+     * @brief set icon from the current theme to UI
+     * @remark if the pixmap is neither cached nor stored in IconAtlas,
+     * placeholder is shown and icon is loaded in background once widget
+     * becomes visible
+     * @param _icon icon name
+     */
+    void setIcon(const QString &_icon);
+
     /**
      * @brief set text to UI
      * @param _text new text
      */
     void setText(const QString &_text);
 
+    /**
+     * @brief split text to lines which fit the width
+     * @remark text is wrapped to two lines at most, long words are broken
+     * and the last line is elided
+     * @param _text text to split
+     * @param _font font which is used for painting
+     * @param _width available width
+     * @return list of lines
+     */
+    static QStringList textLines(const QString &_text, const QFont &_font,
+                                 const int _width);
+
 public slots:
 
     /**
@@ -95,6 +128,13 @@ signals:
     void widgetPressed();
 
 protected:
+    /**
+     * @brief method which will be called on widget state change
+     * @remark text layout is invalidated on font change
+     * @param _event pointer to change event
+     */
+    void changeEvent(QEvent *_event);
+
     /**
      * @brief method which will be called on key press event
      * @param _pressedKey pointer to pressed key
@@ -109,26 +149,51 @@ protected:
 
     /**
      * @brief method which will be called to paint UI
-     * @remark this method is required to apply custom CSS styles
      * @param _event pointer to paint event
      */
     void paintEvent(QPaintEvent *_event);
 
-private:
-    // ui
     /**
-     * @brief pointer to QLabel with icon
+     * @brief set pixmap which has no icon name, e.g. thumbnail
+     * @param _pixmap new pixmap, device pixel ratio should be set
      */
-    QLabel *m_iconLabel = nullptr;
+    void setPixmap(const QPixmap &_pixmap);
+
+private slots:
     /**
-     * @brief pointer to QLabel with text
+     * @brief set icon which has been loaded in background
+     * @remark icon will be loaded synchronously if loader could not find it
+     * @param _image loaded icon
      */
-    QLabel *m_textLabel = nullptr;
+    void setIconImage(const QImage &_image);
+
+private:
     // properties
+    /**
+     * @brief current icon name, empty if icon has no name
+     */
+    QString m_icon;
+    /**
+     * @brief true if placeholder is shown instead of icon
+     */
+    bool m_iconPending = false;
+    /**
+     * @brief current icon pixmap or placeholder
+     */
+    QPixmap m_pixmap;
     /**
      * @brief UI size
      */
     QSize m_size;
+    /**
+     * @brief current text
+     */
+    QString m_text;
+    /**
+     * @brief wrapped and elided text lines, empty if text should be laid out
+     * again
+     */
+    QStringList m_textLines;
 };
 };
 
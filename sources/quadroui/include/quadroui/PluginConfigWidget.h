@@ -43,6 +43,8 @@ namespace Quadro
 {
 class PluginRepresentationWidget;
 
+struct PluginMetadata;
+
 /**
  * @brief The PluginConfigWidget class provides UI for plugin configuration
  */
@@ -142,6 +144,12 @@ private:
      */
     void createObjects();
 
+    /**
+     * @brief fill known plugin list from received metadata
+     * @param _plugins list of plugin metadata
+     */
+    void updatePlugins(const QList<PluginMetadata> &_plugins);
+
     /**
      * @brief associated plugin group
      */
@@ -0,0 +1,117 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file QuadroItemDelegate.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef QUADROITEMDELEGATE_H
+#define QUADROITEMDELEGATE_H
+
+#include <QSet>
+#include <QStyledItemDelegate>
+
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The QuadroItemDelegate class provides painter of QuadroView items
+ * @remark items are painted in the same way as IconWidget does. Icons are
+ * taken from IconCache or IconAtlas, otherwise placeholder is painted and
+ * icon is loaded by IconLoader in background
+ */
+class QuadroItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief QuadroItemDelegate class constructor
+     * @param _parent pointer to parent object
+     * @param _grid grid size
+     */
+    explicit QuadroItemDelegate(QObject *_parent, const int _grid);
+
+    /**
+     * @brief QuadroItemDelegate class destructor
+     */
+    virtual ~QuadroItemDelegate();
+
+    /**
+     * @brief paint item
+     * @param _painter pointer to painter
+     * @param _option style options
+     * @param _index item index
+     */
+    void paint(QPainter *_painter, const QStyleOptionViewItem &_option,
+               const QModelIndex &_index) const;
+
+    /**
+     * @brief item size
+     * @param _option style options
+     * @param _index item index
+     * @return grid size for any item
+     */
+    QSize sizeHint(const QStyleOptionViewItem &_option,
+                   const QModelIndex &_index) const;
+
+private slots:
+    /**
+     * @brief cache icon loaded in background and repaint view
+     * @param _name icon name
+     * @param _image loaded icon or null image if it could not be found
+     */
+    void setIconImage(const QString &_name, const QImage &_image);
+
+private:
+    /**
+     * @brief grid size
+     */
+    int m_grid = 0;
+    /**
+     * @brief logical icon size
+     */
+    QSize m_iconSize;
+    /**
+     * @brief icons which could not be found
+     */
+    QSet<QString> m_missing;
+    /**
+     * @brief icons which are being loaded
+     */
+    mutable QSet<QString> m_pending;
+    // methods
+    /**
+     * @brief find icon pixmap
+     * @remark icon is requested from IconLoader if it is not cached
+     * @param _name icon name
+     * @return icon pixmap or placeholder if icon is being loaded
+     */
+    QPixmap iconPixmap(const QString &_name) const;
+};
+};
+
+
+#endif /* QUADROITEMDELEGATE_H */
@@ -0,0 +1,172 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file QuadroItemModel.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef QUADROITEMMODEL_H
+#define QUADROITEMMODEL_H
+
+#include <QAbstractListModel>
+
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The QuadroItemModel class provides flat model of icon items which
+ * are shown by QuadroView
+ * @remark icons are stored by names and are rasterized by delegate on paint
+ */
+class QuadroItemModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief custom item data roles
+     */
+    enum Role {
+        /**
+         * @brief icon name from the current theme
+         */
+        IconNameRole = Qt::UserRole + 1,
+        /**
+         * @brief user data associated with item
+         */
+        ItemDataRole
+    };
+
+    /**
+     * @brief item types
+     */
+    enum ItemType {
+        /**
+         * @brief item which is handled by view owner
+         */
+        GenericType = 0,
+        /**
+         * @brief application, data contains pointer to ApplicationItem
+         */
+        ApplicationType,
+        /**
+         * @brief file entry, data contains absolute file path
+         */
+        FileType
+    };
+
+    /**
+     * @brief model item
+     */
+    struct Item {
+        /**
+         * @brief item text
+         */
+        QString text;
+        /**
+         * @brief icon name
+         */
+        QString icon;
+        /**
+         * @brief item tooltip
+         */
+        QString toolTip;
+        /**
+         * @brief user data associated with item, e.g. file path
+         */
+        QVariant data;
+        /**
+         * @brief item type
+         */
+        ItemType type = GenericType;
+    };
+
+    /**
+     * @brief QuadroItemModel class constructor
+     * @param _parent pointer to parent object
+     */
+    explicit QuadroItemModel(QObject *_parent);
+
+    /**
+     * @brief QuadroItemModel class destructor
+     */
+    virtual ~QuadroItemModel();
+
+    /**
+     * @brief append item
+     * @param _item new item
+     */
+    void addItem(const Item &_item);
+
+    /**
+     * @brief append items at once
+     * @param _items new items
+     */
+    void addItems(const QList<Item> &_items);
+
+    /**
+     * @brief remove all items
+     */
+    void clear();
+
+    /**
+     * @brief item data
+     * @param _index model index
+     * @param _role data role
+     * @return data of the specified role
+     */
+    QVariant data(const QModelIndex &_index, int _role) const;
+
+    /**
+     * @brief get item by row
+     * @param _row item row
+     * @return item at row
+     */
+    Item item(const int _row) const;
+
+    /**
+     * @brief set item icon
+     * @param _row item row
+     * @param _icon icon name
+     */
+    void setIcon(const int _row, const QString &_icon);
+
+    /**
+     * @brief item count
+     * @param _parent parent index, it should be invalid for list model
+     * @return item count
+     */
+    int rowCount(const QModelIndex &_parent = QModelIndex()) const;
+
+private:
+    /**
+     * @brief model items
+     */
+    QList<Item> m_items;
+};
+};
+
+
+#endif /* QUADROITEMMODEL_H */
@@ -26,18 +26,26 @@
 #ifndef QUADROUI_H
 #define QUADROUI_H
 
+#include "AbstractImageLoader.h"
 #include "AppIconWidget.h"
 #include "EditAppWindow.h"
 #include "FileIconWidget.h"
 #include "FileInfoWindow.h"
+#include "IconAtlas.h"
+#include "IconCache.h"
+#include "IconLoader.h"
 #include "IconWidget.h"
 #include "PluginConfigWidget.h"
 #include "PluginContainer.h"
 #include "PluginRepresentationWidget.h"
 #include "PluginWidget.h"
+#include "QuadroItemDelegate.h"
+#include "QuadroItemModel.h"
+#include "QuadroView.h"
 #include "QuadroWidget.h"
 #include "SearchBar.h"
 #include "StandaloneAppWidget.h"
+#include "ThumbnailLoader.h"
 #include "WebAppWidget.h"
 
 #endif /* QUADROUI_H */
@@ -0,0 +1,282 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file QuadroView.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef QUADROVIEW_H
+#define QUADROVIEW_H
+
+#include <QFileInfo>
+#include <QListView>
+
+
+class QMenu;
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+class ApplicationItem;
+class QuadroItemModel;
+
+/**
+ * @brief The QuadroView class provides model based icon grid
+ * @remark unlike QuadroWidget it does not create widget per item, only
+ * visible items are painted, thus it should be used instead of QuadroWidget
+ * filled by AppIconWidget or FileIconWidget. Applications and files added by
+ * addApplications() and addFiles() are handled in the same way as these
+ * widgets do, context menus are created on request only. Context menus of
+ * other items should be created by owner on contextMenuRequested() signal
+ */
+class QuadroView : public QListView
+{
+    Q_OBJECT
+    Q_PROPERTY(int grid READ grid)
+    Q_PROPERTY(QString title READ title)
+
+public:
+    /**
+     * @brief QuadroView class constructor
+     * @param _parent pointer to parent object
+     * @param _grid grid size
+     * @param _widgetTitle widget title
+     */
+    explicit QuadroView(QWidget *_parent, const int _grid,
+                        const QString _widgetTitle = "none");
+
+    /**
+     * @brief QuadroView class destructor
+     */
+    virtual ~QuadroView();
+
+    /**
+     * @brief append applications
+     * @remark application is run on press, replacement of AppIconWidget
+     * @param _items list of applications
+     */
+    void addApplications(const QList<ApplicationItem *> &_items);
+
+    /**
+     * @brief append file entries
+     * @remark openFile() is emitted on press, replacement of FileIconWidget
+     * @param _entries list of file entries
+     * @param _icons icon names in the same order as entries, e.g. from
+     * FileManagerCore::iconNamesByFileNames()
+     */
+    void addFiles(const QFileInfoList &_entries, const QStringList &_icons);
+
+    /**
+     * @brief grid size
+     * @return current widget grid size
+     */
+    int grid() const;
+
+    /**
+     * @brief items model
+     * @return pointer to model which is shown by view
+     */
+    QuadroItemModel *itemModel() const;
+
+    /**
+     * @brief widget title (will not be shown by default)
+     * @return title as a string
+     */
+    QString title() const;
+
+public slots:
+
+    /**
+     * @brief navigate on items
+     * @param _dx horizontal shift
+     * @param _dy vertical shift
+     */
+    void moveFocus(const int _dx, const int _dy);
+
+    /**
+     * @brief move focus down
+     */
+    void moveFocusDown();
+
+    /**
+     * @brief move focus left
+     */
+    void moveFocusLeft();
+
+    /**
+     * @brief move focus right
+     */
+    void moveFocusRight();
+
+    /**
+     * @brief move focus up
+     */
+    void moveFocusUp();
+
+    /**
+     * @brief reset focus
+     */
+    void resetFocus();
+
+signals:
+    /**
+     * @brief the signal emitted when application has been successfully run
+     */
+    void applicationIsRunning();
+
+    /**
+     * @brief signal which will be emitted when context menu has been
+     * requested for item
+     * @param _index item index
+     * @param _pos global mouse position
+     */
+    void contextMenuRequested(const QModelIndex &_index, const QPoint &_pos);
+
+    /**
+     * @brief signal which will be emitted when item will be pressed
+     * @param _index item index
+     */
+    void itemPressed(const QModelIndex &_index);
+
+    /**
+     * @brief signal which will be emitted when item will be pressed by
+     * middle button
+     * @param _index item index
+     */
+    void itemMiddlePressed(const QModelIndex &_index);
+
+    /**
+     * @brief signal which will be emitted when directory should be opened in
+     * new tab
+     * @param _info file entry
+     */
+    void openDirInNewTab(const QFileInfo &_info);
+
+    /**
+     * @brief signal which will be emitted when file entry has been pressed
+     * @param _info file entry
+     */
+    void openFile(const QFileInfo &_info);
+
+    /**
+     * @brief the signal emitted when the new application should be run as a
+     * standalone
+     * @param _exec executable name
+     * @param _name application name
+     */
+    void standaloneApplicationRequested(const QStringList &_exec,
+                                        const QString &_name);
+
+protected:
+    /**
+     * @brief method which will be called when it receives focus
+     * @param _event pointer to focus event
+     */
+    void focusInEvent(QFocusEvent *_event);
+
+    /**
+     * @brief method which will be called on key press event
+     * @param _pressedKey pointer to pressed key
+     */
+    void keyPressEvent(QKeyEvent *_pressedKey);
+
+    /**
+     * @brief method which will be called on mouse event
+     * @param _event pointer to mouse event
+     */
+    void mousePressEvent(QMouseEvent *_event);
+
+private slots:
+    /**
+     * @brief run application or open file entry
+     * @param _index item index
+     */
+    void activateItem(const QModelIndex &_index);
+
+    /**
+     * @brief run application or open directory in new tab
+     * @param _index item index
+     */
+    void activateItemInNewTab(const QModelIndex &_index);
+
+    /**
+     * @brief method which will be called on context menu request
+     * @param _pos current mouse position
+     */
+    void showContextMenu(const QPoint &_pos);
+
+private:
+    // properties
+    /**
+     * @brief grid size
+     */
+    int m_grid = 0;
+    /**
+     * @brief items model
+     */
+    QuadroItemModel *m_model = nullptr;
+    /**
+     * @brief widget title
+     */
+    QString m_title;
+    // methods
+    /**
+     * @brief application of item
+     * @param _index item index
+     * @return pointer to application or nullptr if item is not application
+     */
+    ApplicationItem *applicationItem(const QModelIndex &_index) const;
+    /**
+     * @brief create context menu of application
+     * @param _item pointer to application
+     * @return menu which will be deleted on close
+     */
+    QMenu *createApplicationMenu(ApplicationItem *_item);
+    /**
+     * @brief create context menu of file entry
+     * @param _info file entry
+     * @return menu which will be deleted on close
+     */
+    QMenu *createFileMenu(const QFileInfo &_info);
+    /**
+     * @brief file entry of item
+     * @param _index item index
+     * @return file entry or empty entry if item is not file
+     */
+    QFileInfo fileInfo(const QModelIndex &_index) const;
+    /**
+     * @brief run application detached
+     * @param _item pointer to application
+     */
+    void runApplication(ApplicationItem *_item);
+    /**
+     * @brief item counts in one string
+     * @return item count
+     */
+    int stringItemCount() const;
+};
+};
+
+
+#endif /* QUADROVIEW_H */
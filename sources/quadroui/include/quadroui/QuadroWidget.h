@@ -39,6 +39,8 @@ namespace Quadro
 {
 /**
  * @brief The QuadroWidget class provides main UI container
+ * @remark it creates widget per item, thus application and file grids should
+ * use QuadroView instead
  */
 class QuadroWidget : public QScrollArea
 {
@@ -67,6 +69,15 @@ public:
      */
     virtual ~QuadroWidget();
 
+    /**
+     * @brief add widgets to layout at once
+     * @remark layout geometry will be updated only once after all widgets
+     * have been added, thus this method should be used instead of adding
+     * widgets one by one
+     * @param _widgets list of widgets
+     */
+    void addWidgets(const QList<QWidget *> &_widgets);
+
     /**
      * @brief clear widget
      */
@@ -78,6 +89,34 @@ public:
      */
     int grid() const;
 
+    /**
+     * @brief move all widgets from layout to recycling pool
+     * @remark widgets are hidden and kept alive, they may be taken back by
+     * recycledWidget(). Pool size is limited by @ref RECYCLING_POOL_SIZE, the
+     * rest widgets will be deleted
+     */
+    void recycleLayout();
+
+    /**
+     * @brief take widget of the specified type from recycling pool
+     * @remark widget should be rebound to the new item and added to layout
+     * again, e.g. by addWidgets()
+     * @tparam T widget type
+     * @return pointer to widget or nullptr if there is no such widget
+     */
+    template <class T> T *recycledWidget()
+    {
+        for (int i = 0; i < m_pool.count(); i++) {
+            T *widget = qobject_cast<T *>(m_pool.at(i));
+            if (!widget)
+                continue;
+            m_pool.removeAt(i);
+            return widget;
+        }
+
+        return nullptr;
+    }
+
     /**
      * @brief widget title (will not be shown by default)
      * @return title as a string
@@ -148,6 +187,10 @@ private:
      * @brief main widget object
      */
     QWidget *m_widget = nullptr;
+    /**
+     * @brief recycled widgets
+     */
+    QList<QWidget *> m_pool;
     // methods
     /**
      * @brief create object actions
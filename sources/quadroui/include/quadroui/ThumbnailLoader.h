@@ -0,0 +1,96 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file ThumbnailLoader.h
+ * Header of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#ifndef THUMBNAILLOADER_H
+#define THUMBNAILLOADER_H
+
+#include "AbstractImageLoader.h"
+
+
+/**
+ * @namespace Quadro
+ */
+namespace Quadro
+{
+/**
+ * @brief The ThumbnailLoader class provides background thumbnail generation
+ * @remark thumbnails are stored according to freedesktop thumbnail managing
+ * standard https://specifications.freedesktop.org/thumbnail-spec/ and
+ * existing thumbnails are reused if their modification time matches. Only
+ * image formats which are supported by Qt are handled
+ */
+class ThumbnailLoader : public AbstractImageLoader
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief ThumbnailLoader class constructor
+     * @param _parent pointer to parent object
+     */
+    explicit ThumbnailLoader(QObject *_parent);
+
+    /**
+     * @brief ThumbnailLoader class destructor
+     */
+    virtual ~ThumbnailLoader();
+
+    /**
+     * @brief shared loader instance
+     * @return pointer to loader which is owned by application
+     */
+    static ThumbnailLoader *instance();
+
+    /**
+     * @brief check whether thumbnail may be generated for file
+     * @remark file content is not read here
+     * @param _path path to file
+     * @return true if file format is supported
+     */
+    static bool isSupported(const QString &_path);
+
+protected:
+    /**
+     * @brief find saved thumbnail or generate new one
+     * @param _source path to file
+     * @param _size maximal thumbnail size
+     * @return thumbnail or null image if it could not be generated
+     */
+    QImage load(const QString &_source, const QSize &_size) const;
+
+private:
+    /**
+     * @brief save thumbnail to cache
+     * @param _image thumbnail image
+     * @param _fileName path to thumbnail file
+     * @return true if thumbnail has been saved
+     */
+    static bool save(const QImage &_image, const QString &_fileName);
+};
+};
+
+
+#endif /* THUMBNAILLOADER_H */
@@ -0,0 +1,208 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file AbstractImageLoader.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadroui/QuadroUi.h"
+
+#include <QThreadPool>
+#include <QWidget>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <quadrocore/Quadro.h>
+
+using namespace Quadro;
+
+
+/**
+ * @class AbstractImageLoader
+ */
+/**
+ * @fn AbstractImageLoader
+ */
+AbstractImageLoader::AbstractImageLoader(QObject *_parent, const int _threads)
+    : QObject(_parent)
+    , m_threads(_threads)
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+
+    m_pool = new QThreadPool(this);
+    m_pool->setMaxThreadCount(m_threads);
+}
+
+
+/**
+ * @fn ~AbstractImageLoader
+ */
+AbstractImageLoader::~AbstractImageLoader()
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn isPending
+ */
+bool AbstractImageLoader::isPending(QObject *_receiver) const
+{
+    for (auto &request : m_running) {
+        if (request.receiver == _receiver)
+            return true;
+    }
+    for (auto &request : m_queue) {
+        if (request.receiver == _receiver)
+            return true;
+    }
+
+    return false;
+}
+
+
+/**
+ * @fn request
+ */
+void AbstractImageLoader::request(QObject *_receiver, const char *_method,
+                                  const QString &_source, const QSize &_size)
+{
+    qCDebug(LOG_UILIB) << "Image request for" << _source << "with size"
+                       << _size;
+
+    Request request;
+    request.receiver = _receiver;
+    request.method = _method;
+    request.source = _source;
+    request.size = _size;
+    request.withSource = false;
+
+    return enqueue(request);
+}
+
+
+/**
+ * @fn requestWithSource
+ */
+void AbstractImageLoader::requestWithSource(QObject *_receiver,
+                                            const char *_method,
+                                            const QString &_source,
+                                            const QSize &_size)
+{
+    qCDebug(LOG_UILIB) << "Image request for" << _source << "with size"
+                       << _size;
+
+    Request request;
+    request.receiver = _receiver;
+    request.method = _method;
+    request.source = _source;
+    request.size = _size;
+    request.withSource = true;
+
+    return enqueue(request);
+}
+
+
+/**
+ * @fn cancel
+ */
+void AbstractImageLoader::cancel(QObject *_receiver)
+{
+    for (int i = m_queue.count() - 1; i >= 0; i--) {
+        if (m_queue.at(i).receiver == _receiver)
+            m_queue.removeAt(i);
+    }
+    for (auto &request : m_running) {
+        if (request.receiver == _receiver)
+            request.receiver.clear();
+    }
+}
+
+
+/**
+ * @fn wait
+ */
+void AbstractImageLoader::wait()
+{
+    m_queue.clear();
+    m_pool->waitForDone();
+}
+
+
+/**
+ * @fn finished
+ */
+void AbstractImageLoader::finished(const int _id, const QImage &_image)
+{
+    Request request = m_running.take(_id);
+    if ((request.receiver) && (request.withSource))
+        QMetaObject::invokeMethod(request.receiver, request.method.constData(),
+                                  Q_ARG(QString, request.source),
+                                  Q_ARG(QImage, _image));
+    else if (request.receiver)
+        QMetaObject::invokeMethod(request.receiver, request.method.constData(),
+                                  Q_ARG(QImage, _image));
+    else
+        qCDebug(LOG_UILIB) << "Request for" << request.source
+                           << "has been cancelled";
+
+    schedule();
+}
+
+
+/**
+ * @fn enqueue
+ */
+void AbstractImageLoader::enqueue(const Request &_request)
+{
+    m_queue.append(_request);
+
+    schedule();
+}
+
+
+/**
+ * @fn schedule
+ */
+void AbstractImageLoader::schedule()
+{
+    while ((m_running.count() < m_threads) && (!m_queue.isEmpty())) {
+        Request request = m_queue.takeLast();
+        if (!request.receiver)
+            continue;
+        // widget has been scrolled out or hidden
+        QWidget *widget = qobject_cast<QWidget *>(request.receiver);
+        if ((widget) && (widget->visibleRegion().isEmpty())) {
+            qCDebug(LOG_UILIB) << "Drop request for" << request.source;
+            continue;
+        }
+
+        int id = ++m_lastRequest;
+        m_running[id] = request;
+        QString source = request.source;
+        QSize size = request.size;
+        QtConcurrent::run(m_pool, [this, id, source, size]() {
+            QImage image = load(source, size);
+            QMetaObject::invokeMethod(this, "finished", Qt::QueuedConnection,
+                                      Q_ARG(int, id), Q_ARG(QImage, image));
+        });
+    }
+}
@@ -46,19 +46,10 @@ using namespace Quadro;
 AppIconWidget::AppIconWidget(ApplicationItem *_appItem, const int _size,
                              QWidget *_parent)
     : IconWidget(_size, _parent)
-    , m_item(_appItem)
 {
     qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
 
-    setIcon(m_item->appIcon());
-    setText(m_item->name());
-    QStringList tooltip;
-    if (!m_item->genericName().isEmpty())
-        tooltip.append(m_item->genericName());
-    if (!m_item->comment().isEmpty())
-        tooltip.append(m_item->comment());
-    setToolTip(tooltip.join('\n'));
-    createActions();
+    setItem(_appItem);
 
     connect(this, SIGNAL(widgetPressed()), this, SLOT(run()));
 }
@@ -84,11 +75,41 @@ ApplicationItem *AppIconWidget::associatedItem()
 }
 
 
+/**
+ * @fn setItem
+ */
+void AppIconWidget::setItem(ApplicationItem *_appItem)
+{
+    qCDebug(LOG_UILIB) << "Bind to" << _appItem->name();
+
+    // arguments are selected for the specific application
+    if (m_item != _appItem)
+        m_args.clear();
+    m_item = _appItem;
+
+    setIcon(m_item->icon());
+    setText(m_item->name());
+    QStringList tooltip;
+    if (!m_item->genericName().isEmpty())
+        tooltip.append(m_item->genericName());
+    if (!m_item->comment().isEmpty())
+        tooltip.append(m_item->comment());
+    setToolTip(tooltip.join('\n'));
+}
+
+
 /**
  * @fn showContextMenu
  */
 void AppIconWidget::showContextMenu(const QPoint &_pos)
 {
+    // menu is created on the first request only
+    if (!m_menu)
+        createActions();
+    // favorites state is stored in memory, so it is cheap to check it here
+    m_favoritesAction->setText(FavoritesCore::hasApplication(m_item)
+                                   ? tr("Remove from favorites")
+                                   : tr("Add to favorites"));
     m_menu->popup(mapToGlobal(_pos));
 }
 
@@ -112,7 +133,6 @@ void AppIconWidget::mousePressEvent(QMouseEvent *_event)
 void AppIconWidget::addItemToFavorites()
 {
     FavoritesCore::addToFavorites(m_item);
-    DBusOperations::sendRequestToLibrary("UpdateFavorites");
 }
 
 
@@ -135,7 +155,7 @@ void AppIconWidget::hideApplication()
     m_item->setNoDisplay(true);
     m_item->saveDesktop(
         QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation));
-    DBusOperations::sendRequestToLibrary("UpdateApplications");
+    DBusOperations::sendRequestToLibraryAsync("UpdateApplications");
 }
 
 
@@ -214,10 +234,6 @@ void AppIconWidget::setUrls()
  */
 void AppIconWidget::createActions()
 {
-    bool isFavorites = DBusOperations::sendRequestToLibrary("Favorites")
-                           .at(0)
-                           .toStringList()
-                           .contains(m_item->name());
     m_menu = new QMenu(this);
 
     m_menu->addAction(QIcon::fromTheme("system-run"), tr("Run application"),
@@ -225,10 +241,9 @@ void AppIconWidget::createActions()
     m_menu->addAction(QIcon::fromTheme("system-run"),
                       tr("Run application in new tab"), this,
                       SLOT(runInNewTab()));
-    m_menu->addAction(QIcon::fromTheme("emblem-favorites"),
-                      isFavorites ? tr("Remove from favorites")
-                                  : tr("Add to favorites"),
-                      this, SLOT(addItemToFavorites()));
+    m_favoritesAction = m_menu->addAction(QIcon::fromTheme("emblem-favorites"),
+                                          tr("Add to favorites"), this,
+                                          SLOT(addItemToFavorites()));
     m_menu->addSeparator();
 
     m_menu->addAction(tr("Select files"), this, SLOT(setFiles()));
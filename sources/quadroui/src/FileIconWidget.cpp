@@ -18,6 +18,7 @@
 
 #include "quadroui/QuadroUi.h"
 
+#include <QGuiApplication>
 #include <QIcon>
 #include <QKeyEvent>
 #include <QMenu>
@@ -36,13 +37,10 @@ using namespace Quadro;
 FileIconWidget::FileIconWidget(const QFileInfo _info, const QIcon _icon,
                                const int _size, QWidget *_parent)
     : IconWidget(_size, _parent)
-    , m_info(_info)
 {
     qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
 
-    setIcon(_icon);
-    setText(m_info.fileName());
-    createActions();
+    setFileInfo(_info, _icon);
 
     connect(this, SIGNAL(widgetPressed()), this, SLOT(openRequested()));
 }
@@ -54,9 +52,11 @@ FileIconWidget::FileIconWidget(const QFileInfo _info, const QIcon _icon,
 FileIconWidget::FileIconWidget(const QString _path, const QString _icon,
                                const int _size, QWidget *_parent)
     : FileIconWidget(QFileInfo(QUrl::fromUserInput(_path).toLocalFile()),
-                     QIcon::fromTheme(_icon), _size, _parent)
+                     QIcon(), _size, _parent)
 {
     qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+
+    setIcon(_icon);
 }
 
 
@@ -67,15 +67,61 @@ FileIconWidget::~FileIconWidget()
 {
     qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
 
+    if (m_requireThumbnail)
+        ThumbnailLoader::instance()->cancel(this);
     delete m_menu;
 }
 
 
+/**
+ * @fn setFileInfo
+ */
+void FileIconWidget::setFileInfo(const QFileInfo &_info, const QIcon &_icon)
+{
+    qCDebug(LOG_UILIB) << "Bind to" << _info.absoluteFilePath();
+
+    bool changed = m_info != _info;
+    m_info = _info;
+    setText(m_info.fileName());
+    // thumbnail of the same file is kept
+    if ((!changed) && (m_showThumbnail))
+        return;
+    if (!_icon.isNull())
+        setIcon(_icon);
+    if (!changed)
+        return;
+
+    // menu depends on entry type, it will be created again on request
+    if (m_menu)
+        m_menu->deleteLater();
+    m_menu = nullptr;
+    // thumbnail of the previous file is not required anymore
+    ThumbnailLoader::instance()->cancel(this);
+    m_showThumbnail = false;
+    m_requireThumbnail
+        = m_info.isFile() && ThumbnailLoader::isSupported(m_info.filePath());
+}
+
+
+/**
+ * @fn setFileInfo
+ */
+void FileIconWidget::setFileInfo(const QString &_path, const QString &_icon)
+{
+    setFileInfo(QFileInfo(QUrl::fromUserInput(_path).toLocalFile()), QIcon());
+    if (!m_showThumbnail)
+        setIcon(_icon);
+}
+
+
 /**
  * @fn showContextMenu
  */
 void FileIconWidget::showContextMenu(const QPoint &_pos)
 {
+    // menu is created on the first request only
+    if (!m_menu)
+        createActions();
     m_menu->popup(mapToGlobal(_pos));
 }
 
@@ -105,6 +151,22 @@ void FileIconWidget::mousePressEvent(QMouseEvent *_event)
 }
 
 
+/**
+ * @fn paintEvent
+ */
+void FileIconWidget::paintEvent(QPaintEvent *_event)
+{
+    IconWidget::paintEvent(_event);
+
+    // request will be dropped if item is scrolled out before start
+    if ((m_requireThumbnail)
+        && (!ThumbnailLoader::instance()->isPending(this)))
+        ThumbnailLoader::instance()->request(
+            this, "setThumbnail", m_info.filePath(),
+            convertSize(size()) * qApp->devicePixelRatio());
+}
+
+
 /**
  * @fn openInNewTabRequested
  */
@@ -123,6 +185,24 @@ void FileIconWidget::openRequested() const
 }
 
 
+/**
+ * @fn setThumbnail
+ */
+void FileIconWidget::setThumbnail(const QImage &_image)
+{
+    m_requireThumbnail = false;
+    if (_image.isNull()) {
+        qCInfo(LOG_UILIB) << "No thumbnail for" << m_info.filePath();
+        return;
+    }
+
+    m_showThumbnail = true;
+    QPixmap pixmap = QPixmap::fromImage(_image);
+    pixmap.setDevicePixelRatio(qApp->devicePixelRatio());
+    setPixmap(pixmap);
+}
+
+
 /**
  * @fn showProperties
  */
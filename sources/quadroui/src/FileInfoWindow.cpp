@@ -69,9 +69,10 @@ void FileInfoWindow::showWindow()
 {
     // set values
     // main
-    ui->label_icon->setPixmap(getIcon().pixmap(100, 100));
+    ui->label_icon->setPixmap(QIcon::fromTheme("system-run").pixmap(100, 100));
     ui->label_name->setText(m_item.fileName());
-    ui->label_typeData->setText(getMime());
+    ui->label_typeData->setText("other");
+    requestMetadata();
     ui->label_pathData->setText(m_item.absolutePath());
 
     // size
@@ -135,29 +136,27 @@ void FileInfoWindow::showWindow()
 
 
 /**
- * @fn getIcon
+ * @fn requestMetadata
  */
-QIcon FileInfoWindow::getIcon() const
+void FileInfoWindow::requestMetadata()
 {
-    QVariantList res = DBusOperations::sendRequestToLibrary(
-        "Icon", QVariantList() << m_item.absoluteFilePath());
-    if (res.isEmpty())
-        return QIcon::fromTheme("system-run");
-    else
-        return QIcon::fromTheme(res.at(0).toString());
-}
-
-
-/**
- * @fn getMime
- */
-QString FileInfoWindow::getMime() const
-{
-    QVariantList res = DBusOperations::sendRequestToLibrary(
-        "MIME", QVariantList() << m_item.absoluteFilePath());
-
-    if (res.isEmpty())
-        return "other";
-    else
-        return res.at(0).toString();
+    QVariantList args = QVariantList() << m_item.absoluteFilePath();
+    QLabel *iconLabel = ui->label_icon;
+    QLabel *mimeLabel = ui->label_typeData;
+
+    DBusOperations::onReply(
+        DBusOperations::sendRequestToLibraryAsync("Icon", args), this,
+        [iconLabel](const QVariantList &_reply) {
+            if (_reply.isEmpty())
+                return;
+            iconLabel->setPixmap(QIcon::fromTheme(_reply.at(0).toString())
+                                     .pixmap(100, 100));
+        });
+    DBusOperations::onReply(
+        DBusOperations::sendRequestToLibraryAsync("MIME", args), this,
+        [mimeLabel](const QVariantList &_reply) {
+            if (_reply.isEmpty())
+                return;
+            mimeLabel->setText(_reply.at(0).toString());
+        });
 }
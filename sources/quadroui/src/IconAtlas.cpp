@@ -0,0 +1,302 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file IconAtlas.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadroui/QuadroUi.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QGuiApplication>
+#include <QIcon>
+#include <QPointer>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <quadrocore/Quadro.h>
+
+#include <cstring>
+
+using namespace Quadro;
+
+
+/**
+ * @brief atlas file signature, "QICA"
+ */
+static const quint32 ATLAS_MAGIC = 0x51494341;
+/**
+ * @brief atlas file format version
+ */
+static const quint32 ATLAS_VERSION = 1;
+/**
+ * @brief record header, it is followed by name, path, padding to 4 bytes and
+ * pixels
+ */
+struct RecordHeader {
+    quint32 nameLength;
+    quint32 pathLength;
+    qint64 modified;
+    quint32 width;
+    quint32 height;
+};
+
+
+/**
+ * @class IconAtlas
+ */
+/**
+ * @fn IconAtlas
+ */
+IconAtlas::IconAtlas(QObject *_parent, const QString &_fileName,
+                     const qreal _ratio)
+    : QObject(_parent)
+    , m_ratio(_ratio)
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+
+    m_file.setFileName(_fileName);
+    load();
+
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(ICON_ATLAS_SAVE_DELAY);
+    connect(&m_saveTimer, SIGNAL(timeout()), this, SLOT(save()));
+}
+
+
+/**
+ * @fn ~IconAtlas
+ */
+IconAtlas::~IconAtlas()
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+
+    if (m_saveTimer.isActive())
+        save();
+}
+
+
+/**
+ * @fn instance
+ */
+IconAtlas *IconAtlas::instance(const QSize &_size)
+{
+    static QHash<QString, QPointer<IconAtlas>> atlases;
+
+    qreal ratio = qApp->devicePixelRatio();
+    QString fileName = QString("%1/%2/%3/%4-%5x%6@%7.atlas")
+                           .arg(QStandardPaths::writableLocation(
+                               QStandardPaths::GenericCacheLocation))
+                           .arg(HOME_PATH)
+                           .arg(ICON_ATLAS_PATH)
+                           .arg(QIcon::themeName())
+                           .arg(_size.width())
+                           .arg(_size.height())
+                           .arg(ratio);
+    if (!atlases[fileName])
+        atlases[fileName]
+            = new IconAtlas(QCoreApplication::instance(), fileName, ratio);
+
+    return atlases[fileName];
+}
+
+
+/**
+ * @fn find
+ */
+bool IconAtlas::find(const QString &_name, QPixmap &_pixmap) const
+{
+    // icon files have been checked on load, thus there is no disk access here
+    auto entry = m_entries.constFind(_name);
+    if (entry == m_entries.constEnd())
+        return false;
+
+    if (entry->pixels) {
+        // image refers to mapped memory, pixmap is the only copy
+        QImage image(entry->pixels, entry->size.width(), entry->size.height(),
+                     4 * entry->size.width(),
+                     QImage::Format_ARGB32_Premultiplied);
+        _pixmap = QPixmap::fromImage(image);
+    } else {
+        _pixmap = QPixmap::fromImage(entry->image);
+    }
+    _pixmap.setDevicePixelRatio(m_ratio);
+
+    return true;
+}
+
+
+/**
+ * @fn insert
+ */
+void IconAtlas::insert(const QString &_name, const QString &_path,
+                       const QImage &_image)
+{
+    qCDebug(LOG_UILIB) << "Store icon" << _name << "from" << _path;
+
+    QFileInfo info(_path);
+    if ((!info.exists()) || (_image.isNull()))
+        return;
+
+    QImage image = _image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    QByteArray name = _name.toUtf8();
+    QByteArray path = info.absoluteFilePath().toUtf8();
+    RecordHeader header;
+    header.nameLength = name.size();
+    header.pathLength = path.size();
+    header.modified = info.lastModified().toMSecsSinceEpoch();
+    header.width = image.width();
+    header.height = image.height();
+
+    m_pending.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    m_pending.append(name);
+    m_pending.append(path);
+    while (m_pending.size() % 4 != 0)
+        m_pending.append('\0');
+    for (int line = 0; line < image.height(); line++)
+        m_pending.append(
+            reinterpret_cast<const char *>(image.constScanLine(line)),
+            4 * image.width());
+
+    // icon is available until the next start, the file is not mapped again
+    Entry entry;
+    entry.size = image.size();
+    entry.image = image;
+    m_entries[_name] = entry;
+
+    m_saveTimer.start();
+}
+
+
+/**
+ * @fn save
+ */
+void IconAtlas::save()
+{
+    if (m_pending.isEmpty())
+        return;
+
+    qCInfo(LOG_UILIB) << "Append" << m_pending.size() << "bytes to"
+                      << m_file.fileName();
+    QDir().mkpath(QFileInfo(m_file.fileName()).absolutePath());
+    QFile file(m_file.fileName());
+    if (!file.open(QIODevice::Append)) {
+        qCWarning(LOG_UILIB) << "Could not open file" << file.fileName();
+        return;
+    }
+
+    if (file.size() == 0) {
+        quint32 header[2] = {ATLAS_MAGIC, ATLAS_VERSION};
+        file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    }
+    file.write(m_pending);
+    m_pending.clear();
+}
+
+
+/**
+ * @fn load
+ */
+void IconAtlas::load()
+{
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qCInfo(LOG_UILIB) << "No atlas found in" << m_file.fileName();
+        return;
+    }
+
+    qint64 size = m_file.size();
+    const uchar *data = size >= 8 ? m_file.map(0, size) : nullptr;
+    quint32 header[2] = {0, 0};
+    if (data)
+        std::memcpy(header, data, sizeof(header));
+    if ((header[0] != ATLAS_MAGIC) || (header[1] != ATLAS_VERSION)) {
+        qCWarning(LOG_UILIB) << "Drop invalid atlas" << m_file.fileName();
+        m_file.close();
+        m_file.remove();
+        return;
+    }
+
+    // later records replace the earlier ones
+    qint64 offset = sizeof(header);
+    qint64 outdated = 0;
+    QHash<QString, qint64> modified;
+    while (size - offset >= static_cast<qint64>(sizeof(RecordHeader))) {
+        RecordHeader record;
+        std::memcpy(&record, data + offset, sizeof(record));
+        qint64 textLength = record.nameLength + record.pathLength;
+        textLength += (4 - (sizeof(record) + textLength) % 4) % 4;
+        qint64 pixelsLength = 4ll * record.width * record.height;
+        qint64 length = sizeof(record) + textLength + pixelsLength;
+        if (length > size - offset)
+            break;
+
+        const char *text
+            = reinterpret_cast<const char *>(data + offset + sizeof(record));
+        QString name = QString::fromUtf8(text, record.nameLength);
+        if (m_entries.contains(name))
+            outdated += m_entries.take(name).length;
+        // each icon file is checked once per session
+        QString path
+            = QString::fromUtf8(text + record.nameLength, record.pathLength);
+        if (!modified.contains(path))
+            modified[path] = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+        if (modified[path] != record.modified) {
+            qCInfo(LOG_UILIB) << "Icon file" << path << "has been changed";
+            outdated += length;
+            offset += length;
+            continue;
+        }
+        Entry entry;
+        entry.size = QSize(record.width, record.height);
+        entry.pixels = data + offset + sizeof(record) + textLength;
+        entry.length = length;
+        m_entries[name] = entry;
+
+        offset += length;
+    }
+    qCInfo(LOG_UILIB) << "Loaded" << m_entries.count() << "icons from"
+                      << m_file.fileName();
+    if ((offset == size) && (outdated <= size / 2))
+        return;
+
+    // rewrite atlas without outdated records and truncated tail
+    qCInfo(LOG_UILIB) << "Compact atlas" << m_file.fileName();
+    QSaveFile file(m_file.fileName());
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(reinterpret_cast<const char *>(header), sizeof(header));
+        for (auto &entry : m_entries) {
+            const uchar *record = entry.pixels + 4 * entry.size.width()
+                                                     * entry.size.height()
+                                  - entry.length;
+            file.write(reinterpret_cast<const char *>(record), entry.length);
+        }
+    }
+    bool saved = file.commit();
+    m_entries.clear();
+    m_file.close();
+    if (saved)
+        load();
+    else
+        qCWarning(LOG_UILIB) << "Could not compact atlas" << m_file.fileName();
+}
@@ -0,0 +1,138 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file IconCache.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadroui/QuadroUi.h"
+
+#include <QCache>
+#include <QGuiApplication>
+#include <QIcon>
+
+#include <quadrocore/Quadro.h>
+
+#include <algorithm>
+
+using namespace Quadro;
+
+
+/**
+ * @brief shared pixmaps, cost is pixmap size in KiB
+ */
+static QCache<QString, QPixmap> &cache()
+{
+    static QCache<QString, QPixmap> pixmaps(ICON_CACHE_SIZE);
+    return pixmaps;
+}
+
+
+/**
+ * @class IconCache
+ */
+/**
+ * @fn clear
+ */
+void IconCache::clear()
+{
+    qCInfo(LOG_UILIB) << "Drop" << cache().count() << "cached pixmaps";
+
+    cache().clear();
+}
+
+
+/**
+ * @fn find
+ */
+bool IconCache::find(const QString &_name, const QSize &_size,
+                     QPixmap &_pixmap)
+{
+    QPixmap *pixmap = cache().object(key(_name, _size));
+    if (!pixmap)
+        return false;
+
+    _pixmap = *pixmap;
+    return true;
+}
+
+
+/**
+ * @fn insert
+ */
+void IconCache::insert(const QString &_name, const QSize &_size,
+                       const QPixmap &_pixmap)
+{
+    int cost = std::max(1, _pixmap.width() * _pixmap.height()
+                               * _pixmap.depth() / 8 / 1024);
+    cache().insert(key(_name, _size), new QPixmap(_pixmap), cost);
+}
+
+
+/**
+ * @fn pixmap
+ */
+QPixmap IconCache::pixmap(const QIcon &_icon, const QSize &_size)
+{
+    if (_icon.name().isEmpty())
+        return _icon.pixmap(_size);
+
+    QPixmap pixmap;
+    if (find(_icon.name(), _size, pixmap))
+        return pixmap;
+
+    pixmap = _icon.pixmap(_size);
+    insert(_icon.name(), _size, pixmap);
+
+    return pixmap;
+}
+
+
+/**
+ * @fn pixmap
+ */
+QPixmap IconCache::pixmap(const QString &_name, const QSize &_size)
+{
+    QPixmap pixmap;
+    if (find(_name, _size, pixmap))
+        return pixmap;
+
+    qCDebug(LOG_UILIB) << "Rasterize icon" << _name << "with size" << _size;
+    pixmap = IconThemeIndex::instance()->icon(_name).pixmap(_size);
+    insert(_name, _size, pixmap);
+
+    return pixmap;
+}
+
+
+/**
+ * @fn key
+ */
+QString IconCache::key(const QString &_name, const QSize &_size)
+{
+    return QString("%1/%2/%3x%4@%5")
+        .arg(QIcon::themeName())
+        .arg(_name)
+        .arg(_size.width())
+        .arg(_size.height())
+        .arg(qApp->devicePixelRatio());
+}
@@ -0,0 +1,124 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file IconLoader.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadroui/QuadroUi.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QIcon>
+#include <QImageReader>
+
+#include <quadrocore/Quadro.h>
+
+#include <algorithm>
+
+using namespace Quadro;
+
+
+/**
+ * @class IconLoader
+ */
+/**
+ * @fn IconLoader
+ */
+IconLoader::IconLoader(QObject *_parent)
+    : AbstractImageLoader(_parent, ICON_LOADER_THREADS)
+    , m_searchPaths(QIcon::themeSearchPaths())
+    , m_theme(QIcon::themeName())
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn ~IconLoader
+ */
+IconLoader::~IconLoader()
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+
+    wait();
+}
+
+
+/**
+ * @fn instance
+ */
+IconLoader *IconLoader::instance()
+{
+    static QPointer<IconLoader> loader;
+    if (!loader)
+        loader = new IconLoader(QCoreApplication::instance());
+
+    return loader;
+}
+
+
+/**
+ * @fn load
+ */
+QImage IconLoader::load(const QString &_source, const QSize &_size) const
+{
+    QString path
+        = QDir::isAbsolutePath(_source)
+              ? _source
+              : IconThemeIndex::instance(m_theme, m_searchPaths)
+                    ->lookup(_source, std::max(_size.width(), _size.height()));
+    if (path.isEmpty()) {
+        qCInfo(LOG_UILIB) << "Could not find icon" << _source << "in theme"
+                          << m_theme;
+        return QImage();
+    }
+
+    QImage image = read(path, _size);
+    // file is required to store icon to atlas
+    image.setText("Source", path);
+
+    return image;
+}
+
+
+/**
+ * @fn read
+ */
+QImage IconLoader::read(const QString &_path, const QSize &_size)
+{
+    QImageReader reader(_path);
+    QSize size = reader.size();
+    // vector images are rendered directly to the required size
+    if ((size.isValid())
+        && ((reader.format() == "svg") || (reader.format() == "svgz")
+            || (size.width() > _size.width())
+            || (size.height() > _size.height())))
+        reader.setScaledSize(size.scaled(_size, Qt::KeepAspectRatio));
+
+    QImage image = reader.read();
+    if (image.isNull())
+        qCWarning(LOG_UILIB) << "Could not read icon" << _path
+                             << reader.errorString();
+
+    return image;
+}
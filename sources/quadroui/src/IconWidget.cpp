@@ -25,10 +25,10 @@
 
 #include "quadroui/QuadroUi.h"
 
+#include <QGuiApplication>
 #include <QKeyEvent>
-#include <QLabel>
 #include <QPainter>
-#include <QVBoxLayout>
+#include <QTextLayout>
 
 #include <quadrocore/Quadro.h>
 
@@ -49,27 +49,12 @@ IconWidget::IconWidget(const int _size, QWidget *_parent)
 
     setContentsMargins(0, 0, 0, 0);
     setFixedSize(m_size);
-    setLayout(new QVBoxLayout(this));
-    layout()->setContentsMargins(0, 0, 0, 0);
-    // icon
-    m_iconLabel = new QLabel(this);
-    m_iconLabel->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
-    layout()->addWidget(m_iconLabel);
-    // text
-    m_textLabel = new QLabel(this);
-    m_textLabel->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
-    m_textLabel->setWordWrap(true);
-    layout()->addWidget(m_textLabel);
-
     setMouseTracking(true);
 
     // context menu
     setContextMenuPolicy(Qt::CustomContextMenu);
     connect(this, SIGNAL(customContextMenuRequested(const QPoint &)), this,
             SLOT(showContextMenu(const QPoint &)));
-
-    // FIXME temporary line
-    setStyleSheet("IconWidget:focus { background: black; color: white; }");
 }
 
 
@@ -80,8 +65,8 @@ IconWidget::~IconWidget()
 {
     qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
 
-    delete m_iconLabel;
-    delete m_textLabel;
+    if (m_iconPending)
+        IconLoader::instance()->cancel(this);
 }
 
 
@@ -94,6 +79,37 @@ QSize IconWidget::convertSize(const QSize &_size) const
 }
 
 
+/**
+ * @fn placeholder
+ */
+QPixmap IconWidget::placeholder(const QSize &_size)
+{
+    // placeholder is cached as well as usual icons
+    QPixmap pixmap;
+    if (IconCache::find("quadro-placeholder", _size, pixmap))
+        return pixmap;
+
+    qreal ratio = qApp->devicePixelRatio();
+    pixmap = QPixmap(_size * ratio);
+    pixmap.setDevicePixelRatio(ratio);
+    pixmap.fill(Qt::transparent);
+
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(128, 128, 128, 48));
+    QRectF rect(QPointF(0, 0), QSizeF(_size));
+    painter.drawRoundedRect(rect.adjusted(_size.width() / 8, _size.height() / 8,
+                                          -_size.width() / 8,
+                                          -_size.height() / 8),
+                            _size.width() / 10, _size.height() / 10);
+    painter.end();
+
+    IconCache::insert("quadro-placeholder", _size, pixmap);
+    return pixmap;
+}
+
+
 /**
  * @fn setIcon
  */
@@ -101,7 +117,44 @@ void IconWidget::setIcon(const QIcon &_icon)
 {
     qCDebug(LOG_UILIB) << "New icon" << _icon.name();
 
-    m_iconLabel->setPixmap(_icon.pixmap(convertSize(m_size)));
+    if ((!_icon.name().isEmpty()) && (_icon.name() == m_icon))
+        return;
+    m_icon = _icon.name();
+    if (m_iconPending)
+        IconLoader::instance()->cancel(this);
+    m_iconPending = false;
+    m_pixmap = IconCache::pixmap(_icon, convertSize(m_size));
+    update();
+}
+
+
+/**
+ * @fn setIcon
+ */
+void IconWidget::setIcon(const QString &_icon)
+{
+    qCDebug(LOG_UILIB) << "New icon" << _icon;
+
+    if ((!_icon.isEmpty()) && (_icon == m_icon))
+        return;
+    m_icon = _icon;
+    // result of the previous request is not required anymore
+    if (m_iconPending)
+        IconLoader::instance()->cancel(this);
+
+    // memory cache is checked first, then icons rasterized by previous runs
+    QSize size = convertSize(m_size);
+    m_pixmap = QPixmap();
+    m_iconPending = false;
+    if ((!_icon.isEmpty()) && (!IconCache::find(_icon, size, m_pixmap))) {
+        if (IconAtlas::instance(size)->find(_icon, m_pixmap)) {
+            IconCache::insert(_icon, size, m_pixmap);
+        } else {
+            m_iconPending = true;
+            m_pixmap = placeholder(size);
+        }
+    }
+    update();
 }
 
 
@@ -112,7 +165,55 @@ void IconWidget::setText(const QString &_text)
 {
     qCDebug(LOG_UILIB) << "New text" << _text;
 
-    m_textLabel->setText(_text);
+    if (m_text == _text)
+        return;
+    m_text = _text;
+    m_textLines.clear();
+    update();
+}
+
+
+/**
+ * @fn textLines
+ */
+QStringList IconWidget::textLines(const QString &_text, const QFont &_font,
+                                  const int _width)
+{
+    QStringList lines;
+    QFontMetrics metrics(_font);
+
+    QTextLayout layout(_text, _font);
+    // long words without spaces are broken as well
+    QTextOption option;
+    option.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+    layout.setTextOption(option);
+    layout.beginLayout();
+    while (lines.count() < 2) {
+        QTextLine line = layout.createLine();
+        if (!line.isValid())
+            break;
+        line.setLineWidth(_width);
+        lines.append(_text.mid(line.textStart(), line.textLength()).trimmed());
+        // the last line contains the rest of text
+        if (lines.count() == 2)
+            lines.last() = metrics.elidedText(_text.mid(line.textStart()),
+                                              Qt::ElideRight, _width);
+    }
+    layout.endLayout();
+
+    return lines;
+}
+
+
+/**
+ * @fn changeEvent
+ */
+void IconWidget::changeEvent(QEvent *_event)
+{
+    if (_event->type() == QEvent::FontChange)
+        m_textLines.clear();
+
+    QWidget::changeEvent(_event);
 }
 
 
@@ -148,8 +249,78 @@ void IconWidget::mousePressEvent(QMouseEvent *_event)
  */
 void IconWidget::paintEvent(QPaintEvent *_event)
 {
-    QStyleOption options;
-    options.init(this);
+    Q_UNUSED(_event);
+
     QPainter painter(this);
-    style()->drawPrimitive(QStyle::PE_Widget, &options, &painter, this);
+    if (hasFocus())
+        painter.fillRect(rect(), palette().color(QPalette::Highlight));
+    painter.setPen(palette().color(hasFocus() ? QPalette::HighlightedText
+                                              : QPalette::WindowText));
+
+    // icon takes upper part of the widget, text is below
+    QRect textRect = rect();
+    textRect.setTop(rect().bottom() - 2 * fontMetrics().lineSpacing());
+    QRect iconRect = rect();
+    iconRect.setBottom(textRect.top());
+
+    if (!m_pixmap.isNull()) {
+        // pixmap is downscaled only if it does not fit
+        QSize pixmapSize = m_pixmap.size() / m_pixmap.devicePixelRatio();
+        if ((pixmapSize.width() > iconRect.width())
+            || (pixmapSize.height() > iconRect.height()))
+            pixmapSize.scale(iconRect.size(), Qt::KeepAspectRatio);
+        QRect target(QPoint(0, 0), pixmapSize);
+        target.moveCenter(iconRect.center());
+        painter.drawPixmap(target, m_pixmap);
+    }
+
+    if (m_textLines.isEmpty())
+        m_textLines = textLines(m_text, font(), width());
+    for (auto &line : m_textLines) {
+        painter.drawText(textRect, Qt::AlignHCenter | Qt::AlignTop, line);
+        textRect.setTop(textRect.top() + fontMetrics().lineSpacing());
+    }
+
+    // request will be dropped if item is scrolled out before start
+    if ((m_iconPending) && (!IconLoader::instance()->isPending(this)))
+        IconLoader::instance()->request(
+            this, "setIconImage", m_icon,
+            convertSize(m_size) * qApp->devicePixelRatio());
+}
+
+
+/**
+ * @fn setPixmap
+ */
+void IconWidget::setPixmap(const QPixmap &_pixmap)
+{
+    // result of the icon request is not required anymore
+    if (m_iconPending)
+        IconLoader::instance()->cancel(this);
+    m_iconPending = false;
+    m_icon.clear();
+    m_pixmap = _pixmap;
+    update();
+}
+
+
+/**
+ * @fn setIconImage
+ */
+void IconWidget::setIconImage(const QImage &_image)
+{
+    m_iconPending = false;
+    QSize size = convertSize(m_size);
+    if (_image.isNull()) {
+        qCInfo(LOG_UILIB) << "Fallback to theme lookup for" << m_icon;
+        m_pixmap = IconCache::pixmap(m_icon, size);
+    } else {
+        m_pixmap = QPixmap::fromImage(_image);
+        m_pixmap.setDevicePixelRatio(qApp->devicePixelRatio());
+        IconCache::insert(m_icon, size, m_pixmap);
+        IconAtlas::instance(size)->insert(m_icon, _image.text("Source"),
+                                          _image);
+    }
+
+    update();
 }
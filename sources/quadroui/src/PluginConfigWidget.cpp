@@ -109,10 +109,17 @@ void PluginConfigWidget::changePluginRepresentation(QListWidgetItem *_current,
         return;
     }
 
+    if (!m_representations.contains(_current->text())) {
+        qCInfo(LOG_UILIB) << "No information received for"
+                          << _current->text();
+        return;
+    }
+
     // main cycle
     qCDebug(LOG_UILIB) << "Change data to" << _current->text();
 
-    if ((!_previous) || (m_representations[_previous->text()]->isHidden())) {
+    if ((!_previous) || (!m_representations.contains(_previous->text()))
+        || (m_representations[_previous->text()]->isHidden())) {
         qCInfo(LOG_UILIB) << "Previous item is hidden, try to find active one";
         for (auto wid : m_representations.values()) {
             if (wid->isHidden())
@@ -266,20 +273,33 @@ void PluginConfigWidget::createActions()
  */
 void PluginConfigWidget::createObjects()
 {
-    // create plugin list
+    // enabled plugins are known already
+    for (auto &plugin : m_enabled)
+        ui->listWidget_enabledPlugins->addItem(plugin);
+
+    // create plugin list once it will be received
+    DBusOperations::onReply(
+        DBusOperations::sendRequestToLibraryAsync("Plugins",
+                                                  QVariantList() << m_group),
+        this, [this](const QVariantList &_reply) {
+            if (_reply.isEmpty())
+                return;
+            updatePlugins(qdbus_cast<QList<PluginMetadata>>(_reply.first()));
+        });
+}
+
+
+/**
+ * @fn updatePlugins
+ */
+void PluginConfigWidget::updatePlugins(const QList<PluginMetadata> &_plugins)
+{
     QStringList knownPluginNames;
-    QVariantList plugins = DBusOperations::toNativeType<QVariantList>(
-        DBusOperations::sendRequestToLibrary("Plugins",
-                                             QVariantList() << m_group)
-            .first());
-    for (auto &plugin : plugins) {
-        QVariantHash metadata
-            = qdbus_cast<QVariantHash>(plugin.value<QDBusArgument>());
-        QString name = metadata["name"].toString();
+    for (auto &metadata : _plugins) {
+        QString name = metadata.name;
         PluginRepresentation *repr = new PluginRepresentation(
-            metadata["author"].toString(), metadata["comment"].toString(),
-            metadata["group"].toString(), metadata["location"].toString(), name,
-            metadata["url"].toString(), metadata["version"].toString(), this);
+            metadata.author, metadata.comment, metadata.group,
+            metadata.location, name, metadata.url, metadata.version, this);
         PluginRepresentationWidget *wid
             = new PluginRepresentationWidget(this, repr);
         m_representations[name] = wid;
@@ -294,6 +314,4 @@ void PluginConfigWidget::createObjects()
     knownPluginNames.sort();
     for (auto &plugin : knownPluginNames)
         ui->listWidget_allPlugins->addItem(plugin);
-    for (auto &plugin : m_enabled)
-        ui->listWidget_enabledPlugins->addItem(plugin);
 }
@@ -0,0 +1,181 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file QuadroItemDelegate.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadroui/QuadroUi.h"
+
+#include <QAbstractItemView>
+#include <QGuiApplication>
+#include <QPainter>
+
+#include <quadrocore/Quadro.h>
+
+using namespace Quadro;
+
+
+/**
+ * @class QuadroItemDelegate
+ */
+/**
+ * @fn QuadroItemDelegate
+ */
+QuadroItemDelegate::QuadroItemDelegate(QObject *_parent, const int _grid)
+    : QStyledItemDelegate(_parent)
+    , m_grid(_grid)
+    , m_iconSize(QSize(_grid * 0.75, _grid * 0.75))
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn ~QuadroItemDelegate
+ */
+QuadroItemDelegate::~QuadroItemDelegate()
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+
+    if (!m_pending.isEmpty())
+        IconLoader::instance()->cancel(this);
+}
+
+
+/**
+ * @fn paint
+ */
+void QuadroItemDelegate::paint(QPainter *_painter,
+                               const QStyleOptionViewItem &_option,
+                               const QModelIndex &_index) const
+{
+    _painter->save();
+
+    // the same colors as IconWidget uses for focused item
+    bool current = _option.state & (QStyle::State_HasFocus
+                                    | QStyle::State_Selected);
+    if (current)
+        _painter->fillRect(_option.rect,
+                           _option.palette.color(QPalette::Highlight));
+    _painter->setPen(_option.palette.color(
+        current ? QPalette::HighlightedText : QPalette::WindowText));
+
+    // icon takes upper part of the cell, text is below
+    QRect textRect = _option.rect;
+    textRect.setTop(_option.rect.bottom()
+                    - 2 * _option.fontMetrics.lineSpacing());
+    QRect iconRect = _option.rect;
+    iconRect.setBottom(textRect.top());
+
+    QPixmap pixmap
+        = iconPixmap(_index.data(QuadroItemModel::IconNameRole).toString());
+    if (!pixmap.isNull()) {
+        // pixmap is downscaled only if it does not fit
+        QSize pixmapSize = pixmap.size() / pixmap.devicePixelRatio();
+        if ((pixmapSize.width() > iconRect.width())
+            || (pixmapSize.height() > iconRect.height()))
+            pixmapSize.scale(iconRect.size(), Qt::KeepAspectRatio);
+        QRect target(QPoint(0, 0), pixmapSize);
+        target.moveCenter(iconRect.center());
+        _painter->drawPixmap(target, pixmap);
+    }
+
+    // the same text layout as IconWidget uses
+    QStringList lines
+        = IconWidget::textLines(_index.data(Qt::DisplayRole).toString(),
+                                _option.font, _option.rect.width());
+    for (auto &line : lines) {
+        _painter->drawText(textRect, Qt::AlignHCenter | Qt::AlignTop, line);
+        textRect.setTop(textRect.top() + _option.fontMetrics.lineSpacing());
+    }
+
+    _painter->restore();
+}
+
+
+/**
+ * @fn sizeHint
+ */
+QSize QuadroItemDelegate::sizeHint(const QStyleOptionViewItem &_option,
+                                   const QModelIndex &_index) const
+{
+    Q_UNUSED(_option);
+    Q_UNUSED(_index);
+
+    return QSize(m_grid, m_grid);
+}
+
+
+/**
+ * @fn setIconImage
+ */
+void QuadroItemDelegate::setIconImage(const QString &_name,
+                                      const QImage &_image)
+{
+    m_pending.remove(_name);
+    if (_image.isNull()) {
+        qCInfo(LOG_UILIB) << "Fallback to theme lookup for" << _name;
+        // named icons are cached by IconCache itself
+        if (IconCache::pixmap(_name, m_iconSize).isNull())
+            m_missing.insert(_name);
+    } else {
+        QPixmap pixmap = QPixmap::fromImage(_image);
+        pixmap.setDevicePixelRatio(qApp->devicePixelRatio());
+        IconCache::insert(_name, m_iconSize, pixmap);
+        IconAtlas::instance(m_iconSize)
+            ->insert(_name, _image.text("Source"), _image);
+    }
+
+    // only visible items are repainted
+    QAbstractItemView *view = qobject_cast<QAbstractItemView *>(parent());
+    if (view)
+        view->viewport()->update();
+}
+
+
+/**
+ * @fn iconPixmap
+ */
+QPixmap QuadroItemDelegate::iconPixmap(const QString &_name) const
+{
+    QPixmap pixmap;
+    if ((_name.isEmpty()) || (m_missing.contains(_name)))
+        return pixmap;
+
+    // memory cache is checked first, then icons rasterized by previous runs
+    if (IconCache::find(_name, m_iconSize, pixmap))
+        return pixmap;
+    if (IconAtlas::instance(m_iconSize)->find(_name, pixmap)) {
+        IconCache::insert(_name, m_iconSize, pixmap);
+        return pixmap;
+    }
+
+    // item will be repainted once icon has been loaded
+    if (!m_pending.contains(_name)) {
+        m_pending.insert(_name);
+        IconLoader::instance()->requestWithSource(
+            const_cast<QuadroItemDelegate *>(this), "setIconImage", _name,
+            m_iconSize * qApp->devicePixelRatio());
+    }
+    return IconWidget::placeholder(m_iconSize);
+}
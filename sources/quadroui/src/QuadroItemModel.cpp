@@ -0,0 +1,150 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file QuadroItemModel.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadroui/QuadroUi.h"
+
+#include <quadrocore/Quadro.h>
+
+using namespace Quadro;
+
+
+/**
+ * @class QuadroItemModel
+ */
+/**
+ * @fn QuadroItemModel
+ */
+QuadroItemModel::QuadroItemModel(QObject *_parent)
+    : QAbstractListModel(_parent)
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn ~QuadroItemModel
+ */
+QuadroItemModel::~QuadroItemModel()
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn addItem
+ */
+void QuadroItemModel::addItem(const Item &_item)
+{
+    return addItems(QList<Item>({_item}));
+}
+
+
+/**
+ * @fn addItems
+ */
+void QuadroItemModel::addItems(const QList<Item> &_items)
+{
+    qCDebug(LOG_UILIB) << "Add" << _items.count() << "items";
+
+    if (_items.isEmpty())
+        return;
+
+    beginInsertRows(QModelIndex(), m_items.count(),
+                    m_items.count() + _items.count() - 1);
+    m_items.append(_items);
+    endInsertRows();
+}
+
+
+/**
+ * @fn clear
+ */
+void QuadroItemModel::clear()
+{
+    beginResetModel();
+    m_items.clear();
+    endResetModel();
+}
+
+
+/**
+ * @fn data
+ */
+QVariant QuadroItemModel::data(const QModelIndex &_index, int _role) const
+{
+    if ((!_index.isValid()) || (_index.row() >= m_items.count()))
+        return QVariant();
+
+    const Item &item = m_items.at(_index.row());
+    switch (_role) {
+    case Qt::DisplayRole:
+        return item.text;
+    case Qt::ToolTipRole:
+        return item.toolTip;
+    case IconNameRole:
+        return item.icon;
+    case ItemDataRole:
+        return item.data;
+    default:
+        return QVariant();
+    }
+}
+
+
+/**
+ * @fn item
+ */
+QuadroItemModel::Item QuadroItemModel::item(const int _row) const
+{
+    return m_items.value(_row);
+}
+
+
+/**
+ * @fn setIcon
+ */
+void QuadroItemModel::setIcon(const int _row, const QString &_icon)
+{
+    qCDebug(LOG_UILIB) << "Set icon" << _icon << "to row" << _row;
+
+    if ((_row < 0) || (_row >= m_items.count())) {
+        qCWarning(LOG_UILIB) << "Invalid row" << _row;
+        return;
+    }
+
+    m_items[_row].icon = _icon;
+    QModelIndex changed = index(_row);
+    emit(dataChanged(changed, changed, QVector<int>({IconNameRole})));
+}
+
+
+/**
+ * @fn rowCount
+ */
+int QuadroItemModel::rowCount(const QModelIndex &_parent) const
+{
+    return _parent.isValid() ? 0 : m_items.count();
+}
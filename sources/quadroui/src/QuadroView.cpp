@@ -0,0 +1,489 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file QuadroView.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadroui/QuadroUi.h"
+
+#include <QKeyEvent>
+#include <QMenu>
+#include <QMessageBox>
+#include <QMouseEvent>
+#include <QPointer>
+#include <QStandardPaths>
+
+#include <quadrocore/Quadro.h>
+
+#include <algorithm>
+
+using namespace Quadro;
+
+
+/**
+ * @class QuadroView
+ */
+/**
+ * @fn QuadroView
+ */
+QuadroView::QuadroView(QWidget *_parent, const int _grid,
+                       const QString _widgetTitle)
+    : QListView(_parent)
+    , m_grid(_grid)
+    , m_title(_widgetTitle)
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+
+    setContentsMargins(0, 0, 0, 0);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+
+    // all items have the same size, thus layout does not ask each of them
+    setViewMode(QListView::IconMode);
+    setFlow(QListView::LeftToRight);
+    setWrapping(true);
+    setMovement(QListView::Static);
+    setResizeMode(QListView::Adjust);
+    setLayoutMode(QListView::Batched);
+    setUniformItemSizes(true);
+    setGridSize(QSize(m_grid, m_grid));
+    setSelectionMode(QAbstractItemView::SingleSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    m_model = new QuadroItemModel(this);
+    setModel(m_model);
+    setItemDelegate(new QuadroItemDelegate(this, m_grid));
+
+    // context menu
+    setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(this, SIGNAL(customContextMenuRequested(const QPoint &)), this,
+            SLOT(showContextMenu(const QPoint &)));
+    // applications and files are handled by view itself
+    connect(this, SIGNAL(itemPressed(const QModelIndex &)), this,
+            SLOT(activateItem(const QModelIndex &)));
+    connect(this, SIGNAL(itemMiddlePressed(const QModelIndex &)), this,
+            SLOT(activateItemInNewTab(const QModelIndex &)));
+}
+
+
+/**
+ * @fn ~QuadroView
+ */
+QuadroView::~QuadroView()
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn addApplications
+ */
+void QuadroView::addApplications(const QList<ApplicationItem *> &_items)
+{
+    QList<QuadroItemModel::Item> items;
+    for (auto &app : _items) {
+        QuadroItemModel::Item item;
+        item.text = app->name();
+        item.icon = app->icon();
+        QStringList tooltip;
+        if (!app->genericName().isEmpty())
+            tooltip.append(app->genericName());
+        if (!app->comment().isEmpty())
+            tooltip.append(app->comment());
+        item.toolTip = tooltip.join('\n');
+        item.data = QVariant::fromValue(static_cast<QObject *>(app));
+        item.type = QuadroItemModel::ApplicationType;
+        items.append(item);
+    }
+
+    return m_model->addItems(items);
+}
+
+
+/**
+ * @fn addFiles
+ */
+void QuadroView::addFiles(const QFileInfoList &_entries,
+                          const QStringList &_icons)
+{
+    if (_entries.count() != _icons.count()) {
+        qCWarning(LOG_UILIB) << "Invalid icon count" << _icons.count()
+                             << "for" << _entries.count() << "entries";
+        return;
+    }
+
+    QList<QuadroItemModel::Item> items;
+    for (int i = 0; i < _entries.count(); i++) {
+        QuadroItemModel::Item item;
+        item.text = _entries.at(i).fileName();
+        item.icon = _icons.at(i);
+        item.data = _entries.at(i).absoluteFilePath();
+        item.type = QuadroItemModel::FileType;
+        items.append(item);
+    }
+
+    return m_model->addItems(items);
+}
+
+
+/**
+ * @fn grid
+ */
+int QuadroView::grid() const
+{
+    return m_grid;
+}
+
+
+/**
+ * @fn itemModel
+ */
+QuadroItemModel *QuadroView::itemModel() const
+{
+    return m_model;
+}
+
+
+/**
+ * @fn title
+ */
+QString QuadroView::title() const
+{
+    return m_title;
+}
+
+
+/**
+ * @fn moveFocus
+ */
+void QuadroView::moveFocus(const int _dx, const int _dy)
+{
+    if (!currentIndex().isValid())
+        return resetFocus();
+    qCDebug(LOG_UILIB) << "Move to dx" << _dx << "dy" << _dy;
+
+    int newRow = currentIndex().row() + _dx * 1 + _dy * stringItemCount();
+    newRow = std::max(0, std::min(newRow, m_model->rowCount() - 1));
+
+    QModelIndex index = m_model->index(newRow);
+    setCurrentIndex(index);
+    return scrollTo(index);
+}
+
+
+/**
+ * @fn moveFocusDown
+ */
+void QuadroView::moveFocusDown()
+{
+    return moveFocus(0, 1);
+}
+
+
+/**
+ * @fn moveFocusLeft
+ */
+void QuadroView::moveFocusLeft()
+{
+    return moveFocus(-1, 0);
+}
+
+
+/**
+ * @fn moveFocusRight
+ */
+void QuadroView::moveFocusRight()
+{
+    return moveFocus(1, 0);
+}
+
+
+/**
+ * @fn moveFocusUp
+ */
+void QuadroView::moveFocusUp()
+{
+    return moveFocus(0, -1);
+}
+
+
+/**
+ * @fn resetFocus
+ */
+void QuadroView::resetFocus()
+{
+    if (m_model->rowCount() == 0)
+        return;
+    setCurrentIndex(m_model->index(0));
+}
+
+
+/**
+ * @fn focusInEvent
+ */
+void QuadroView::focusInEvent(QFocusEvent *_event)
+{
+    QListView::focusInEvent(_event);
+
+    if (!currentIndex().isValid())
+        resetFocus();
+}
+
+
+/**
+ * @fn keyPressEvent
+ */
+void QuadroView::keyPressEvent(QKeyEvent *_pressedKey)
+{
+    switch (_pressedKey->key()) {
+    case Qt::Key_Enter:
+    case Qt::Key_Return:
+        if (currentIndex().isValid())
+            emit(itemPressed(currentIndex()));
+        break;
+    case Qt::Key_Down:
+        return moveFocusDown();
+    case Qt::Key_Left:
+        return moveFocusLeft();
+    case Qt::Key_Right:
+        return moveFocusRight();
+    case Qt::Key_Up:
+        return moveFocusUp();
+    case Qt::Key_Space:
+        if (!fileInfo(currentIndex()).filePath().isEmpty()) {
+            FileInfoWindow *infoWindow
+                = new FileInfoWindow(this, fileInfo(currentIndex()));
+            return infoWindow->showWindow();
+        }
+        break;
+    default:
+        break;
+    }
+
+    QListView::keyPressEvent(_pressedKey);
+}
+
+
+/**
+ * @fn mousePressEvent
+ */
+void QuadroView::mousePressEvent(QMouseEvent *_event)
+{
+    QListView::mousePressEvent(_event);
+
+    QModelIndex index = indexAt(_event->pos());
+    if (!index.isValid())
+        return;
+    if (_event->button() == Qt::LeftButton)
+        emit(itemPressed(index));
+    else if (_event->button() == Qt::MiddleButton)
+        emit(itemMiddlePressed(index));
+}
+
+
+/**
+ * @fn activateItem
+ */
+void QuadroView::activateItem(const QModelIndex &_index)
+{
+    ApplicationItem *app = applicationItem(_index);
+    if (app)
+        return runApplication(app);
+
+    QFileInfo info = fileInfo(_index);
+    if (!info.filePath().isEmpty())
+        emit(openFile(info));
+}
+
+
+/**
+ * @fn activateItemInNewTab
+ */
+void QuadroView::activateItemInNewTab(const QModelIndex &_index)
+{
+    ApplicationItem *app = applicationItem(_index);
+    if (app)
+        return emit(standaloneApplicationRequested(
+            app->generateExec(QVariantHash()), app->name()));
+
+    QFileInfo info = fileInfo(_index);
+    if (info.isDir())
+        emit(openDirInNewTab(info));
+}
+
+
+/**
+ * @fn showContextMenu
+ */
+void QuadroView::showContextMenu(const QPoint &_pos)
+{
+    QModelIndex index = indexAt(_pos);
+    if (!index.isValid())
+        return;
+
+    // menus are cheap to create on request, there is no widget per item
+    QMenu *menu = nullptr;
+    ApplicationItem *app = applicationItem(index);
+    QFileInfo info = fileInfo(index);
+    if (app)
+        menu = createApplicationMenu(app);
+    else if (!info.filePath().isEmpty())
+        menu = createFileMenu(info);
+    else
+        return emit(
+            contextMenuRequested(index, viewport()->mapToGlobal(_pos)));
+
+    menu->setAttribute(Qt::WA_DeleteOnClose);
+    menu->popup(viewport()->mapToGlobal(_pos));
+}
+
+
+/**
+ * @fn applicationItem
+ */
+ApplicationItem *QuadroView::applicationItem(const QModelIndex &_index) const
+{
+    if (!_index.isValid())
+        return nullptr;
+
+    QuadroItemModel::Item item = m_model->item(_index.row());
+    if (item.type != QuadroItemModel::ApplicationType)
+        return nullptr;
+    return qobject_cast<ApplicationItem *>(item.data.value<QObject *>());
+}
+
+
+/**
+ * @fn createApplicationMenu
+ */
+QMenu *QuadroView::createApplicationMenu(ApplicationItem *_item)
+{
+    QMenu *menu = new QMenu(this);
+    // application may be removed while menu is shown
+    QPointer<ApplicationItem> app = _item;
+
+    connect(menu->addAction(QIcon::fromTheme("system-run"),
+                            tr("Run application")),
+            &QAction::triggered, [this, app]() {
+                if (app)
+                    runApplication(app);
+            });
+    connect(menu->addAction(QIcon::fromTheme("system-run"),
+                            tr("Run application in new tab")),
+            &QAction::triggered, [this, app]() {
+                if (app)
+                    emit(standaloneApplicationRequested(
+                        app->generateExec(QVariantHash()), app->name()));
+            });
+    connect(menu->addAction(QIcon::fromTheme("emblem-favorites"),
+                            FavoritesCore::hasApplication(_item)
+                                ? tr("Remove from favorites")
+                                : tr("Add to favorites")),
+            &QAction::triggered, [app]() {
+                if (app)
+                    FavoritesCore::addToFavorites(app);
+            });
+    menu->addSeparator();
+
+    connect(menu->addAction(tr("Edit")), &QAction::triggered, [this, app]() {
+        if (app)
+            (new EditAppWindow(this, app))->showWindow();
+    });
+    connect(menu->addAction(tr("Hide")), &QAction::triggered, [app]() {
+        if (!app)
+            return;
+        app->setNoDisplay(true);
+        app->saveDesktop(QStandardPaths::writableLocation(
+            QStandardPaths::ApplicationsLocation));
+        DBusOperations::sendRequestToLibraryAsync("UpdateApplications");
+    });
+
+    return menu;
+}
+
+
+/**
+ * @fn createFileMenu
+ */
+QMenu *QuadroView::createFileMenu(const QFileInfo &_info)
+{
+    QMenu *menu = new QMenu(this);
+
+    connect(menu->addAction(QIcon::fromTheme(_info.isDir()
+                                                 ? "document-open-folder"
+                                                 : "document-open"),
+                            tr("Open")),
+            &QAction::triggered, [this, _info]() { emit(openFile(_info)); });
+    if (_info.isDir())
+        connect(menu->addAction(QIcon::fromTheme("document-open-folder"),
+                                tr("Open in new tab")),
+                &QAction::triggered,
+                [this, _info]() { emit(openDirInNewTab(_info)); });
+    menu->addSeparator();
+
+    connect(menu->addAction(QIcon::fromTheme("document-properties"),
+                            tr("Properties")),
+            &QAction::triggered, [this, _info]() {
+                (new FileInfoWindow(this, _info))->showWindow();
+            });
+
+    return menu;
+}
+
+
+/**
+ * @fn fileInfo
+ */
+QFileInfo QuadroView::fileInfo(const QModelIndex &_index) const
+{
+    if (!_index.isValid())
+        return QFileInfo();
+
+    QuadroItemModel::Item item = m_model->item(_index.row());
+    if (item.type != QuadroItemModel::FileType)
+        return QFileInfo();
+    return QFileInfo(item.data.toString());
+}
+
+
+/**
+ * @fn runApplication
+ */
+void QuadroView::runApplication(ApplicationItem *_item)
+{
+    if (_item->launch(QVariantHash()))
+        emit(applicationIsRunning());
+    else
+        QMessageBox::critical(
+            this, tr("Error"), tr("Error"),
+            tr("Could not run application %1").arg(_item->exec()));
+}
+
+
+/**
+ * @fn stringItemCount
+ */
+int QuadroView::stringItemCount() const
+{
+    return std::max(1, viewport()->width() / m_grid);
+}
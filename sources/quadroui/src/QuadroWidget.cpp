@@ -73,13 +73,30 @@ QuadroWidget::~QuadroWidget()
 }
 
 
+/**
+ * @fn addWidgets
+ */
+void QuadroWidget::addWidgets(const QList<QWidget *> &_widgets)
+{
+    qCDebug(LOG_UILIB) << "Add" << _widgets.count() << "widgets";
+
+    m_layout->beginInsert();
+    for (auto widget : _widgets) {
+        m_layout->addWidget(widget);
+        widget->show();
+    }
+    m_layout->endInsert();
+}
+
+
 /**
  * @fn clearLayout
  */
 void QuadroWidget::clearLayout()
 {
     QLayoutItem *item;
-    while ((item = m_widget->layout()->takeAt(0))) {
+    // take items from the end to avoid shifting of the rest
+    while ((item = m_widget->layout()->takeAt(m_layout->count() - 1))) {
         item->widget()->deleteLater();
         delete item;
     }
@@ -97,6 +114,31 @@ int QuadroWidget::grid() const
 }
 
 
+/**
+ * @fn recycleLayout
+ */
+void QuadroWidget::recycleLayout()
+{
+    // widgets are hidden one by one, thus relayout once at the end
+    m_layout->beginInsert();
+    QLayoutItem *item;
+    while ((item = m_widget->layout()->takeAt(m_layout->count() - 1))) {
+        QWidget *widget = item->widget();
+        delete item;
+        if (m_pool.count() < RECYCLING_POOL_SIZE) {
+            widget->hide();
+            // keep layout order, thus widgets will likely get the same items
+            m_pool.prepend(widget);
+        } else {
+            widget->deleteLater();
+        }
+    }
+    m_layout->endInsert();
+
+    setFocus();
+}
+
+
 /**
  * @fn title
  */
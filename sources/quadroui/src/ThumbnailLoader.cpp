@@ -0,0 +1,204 @@
+/***************************************************************************
+ *   This file is part of quadro                                           *
+ *                                                                         *
+ *   quadro is free software: you can redistribute it and/or               *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation, either version 3 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   quadro is distributed in the hope that it will be useful,             *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with quadro. If not, see http://www.gnu.org/licenses/           *
+ ***************************************************************************/
+/**
+ * @file ThumbnailLoader.cpp
+ * Source code of quadro library
+ * @author Evgeniy Alekseev
+ * @copyright GPLv3
+ * @bug https://github.com/arcan1s/quadro-core/issues
+ */
+
+
+
+#include "quadroui/QuadroUi.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+
+#include <quadrocore/Quadro.h>
+
+#include <algorithm>
+
+using namespace Quadro;
+
+
+/**
+ * @class ThumbnailLoader
+ */
+/**
+ * @fn ThumbnailLoader
+ */
+ThumbnailLoader::ThumbnailLoader(QObject *_parent)
+    : AbstractImageLoader(_parent, THUMBNAIL_THREADS)
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+}
+
+
+/**
+ * @fn ~ThumbnailLoader
+ */
+ThumbnailLoader::~ThumbnailLoader()
+{
+    qCDebug(LOG_UILIB) << __PRETTY_FUNCTION__;
+
+    wait();
+}
+
+
+/**
+ * @fn instance
+ */
+ThumbnailLoader *ThumbnailLoader::instance()
+{
+    static QPointer<ThumbnailLoader> loader;
+    if (!loader)
+        loader = new ThumbnailLoader(QCoreApplication::instance());
+
+    return loader;
+}
+
+
+/**
+ * @fn isSupported
+ */
+bool ThumbnailLoader::isSupported(const QString &_path)
+{
+    static const QList<QByteArray> formats
+        = QImageReader::supportedImageFormats();
+
+    return formats.contains(QFileInfo(_path).suffix().toLower().toUtf8());
+}
+
+
+/**
+ * @fn load
+ */
+QImage ThumbnailLoader::load(const QString &_source, const QSize &_size) const
+{
+    QFileInfo info(_source);
+    QString uri = QUrl::fromLocalFile(info.absoluteFilePath())
+                      .toString(QUrl::FullyEncoded);
+    QString mtime = QString::number(info.lastModified().toTime_t());
+    QString hash = QString::fromLatin1(
+        QCryptographicHash::hash(uri.toUtf8(), QCryptographicHash::Md5)
+            .toHex());
+
+    // normal flavor is 128px, large one is 256px
+    int pixels = std::max(_size.width(), _size.height()) <= 128 ? 128 : 256;
+    QString root = QString("%1/thumbnails")
+                       .arg(QStandardPaths::writableLocation(
+                           QStandardPaths::GenericCacheLocation));
+    QString fileName = QString("%1/%2/%3.png")
+                           .arg(root)
+                           .arg(pixels == 128 ? "normal" : "large")
+                           .arg(hash);
+    QString failName
+        = QString("%1/fail/quadro/%2.png").arg(root).arg(hash);
+
+    // check saved thumbnails first
+    QImage image;
+    for (auto &saved : {fileName, failName}) {
+        QImageReader reader(saved, "png");
+        if ((!reader.canRead()) || (reader.text("Thumb::URI") != uri)
+            || (reader.text("Thumb::MTime") != mtime))
+            continue;
+        if (saved == failName)
+            return QImage();
+        image = reader.read();
+        break;
+    }
+
+    if (image.isNull()) {
+        // decode at target size if format allows it
+        QImageReader reader(_source);
+        reader.setAutoTransform(true);
+        QSize original = reader.size();
+        if ((original.isValid())
+            && ((original.width() > pixels) || (original.height() > pixels)))
+            reader.setScaledSize(
+                original.scaled(pixels, pixels, Qt::KeepAspectRatio));
+        image = reader.read();
+        if ((!image.isNull())
+            && ((image.width() > pixels) || (image.height() > pixels)))
+            image = image.scaled(pixels, pixels, Qt::KeepAspectRatio,
+                                 Qt::SmoothTransformation);
+
+        // failed thumbnail is saved as well to avoid repeated decoding
+        bool failed = image.isNull();
+        QImage thumbnail = image;
+        if (failed) {
+            thumbnail = QImage(1, 1, QImage::Format_ARGB32);
+            thumbnail.fill(Qt::transparent);
+        }
+        thumbnail.setText("Thumb::URI", uri);
+        thumbnail.setText("Thumb::MTime", mtime);
+        thumbnail.setText("Software", "quadro");
+        save(thumbnail, failed ? failName : fileName);
+        if (failed) {
+            qCInfo(LOG_UILIB) << "Could not read image" << _source;
+            return QImage();
+        }
+    }
+
+    // small images are not upscaled
+    if ((image.width() > _size.width()) || (image.height() > _size.height()))
+        image = image.scaled(_size, Qt::KeepAspectRatio,
+                             Qt::SmoothTransformation);
+
+    return image;
+}
+
+
+/**
+ * @fn save
+ */
+bool ThumbnailLoader::save(const QImage &_image, const QString &_fileName)
+{
+    QString directory = QFileInfo(_fileName).absolutePath();
+    if (!QDir().mkpath(directory)) {
+        qCWarning(LOG_UILIB) << "Could not create directory" << directory;
+        return false;
+    }
+    QFile::setPermissions(directory, QFileDevice::ReadOwner
+                                         | QFileDevice::WriteOwner
+                                         | QFileDevice::ExeOwner);
+
+    // file is written to temporary one and renamed as standard requires
+    QSaveFile file(_fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(LOG_UILIB) << "Could not open file" << _fileName;
+        return false;
+    }
+    file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    QImageWriter writer(&file, "png");
+    if (!writer.write(_image)) {
+        qCWarning(LOG_UILIB) << "Could not write thumbnail" << _fileName
+                             << writer.errorString();
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}